@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <Core/MappedFile.hpp>
+#include <Util/Log.hpp>
+
+namespace Core {
+    // On-disk layout of an asset pack, written by Tools/AssetCooker. Everything
+    // is little-endian and read in place from the mapping:
+    //
+    //   Header | asset data, each blob aligned to DataAlignment | Entry[entryCount]
+    //
+    // Entries are sorted by the FNV-1a hash of the asset's path relative to the
+    // cooked directory ("shrek.png", "fonts/hud.ttf"), so lookups are a binary search.
+    namespace PackFormat {
+        constexpr uint32_t Magic = 0x4B415047; // "GPAK"
+        constexpr uint32_t Version = 1;
+        constexpr size_t DataAlignment = 64;
+
+        enum class AssetType : uint32_t {
+            Blob = 0,       // the file's bytes as they were
+            Texture = 1,    // RGBA8, top row first, mip levels back to back, largest first
+        };
+
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t entryCount;
+            uint32_t reserved;
+            uint64_t indexOffset;
+        };
+
+        struct Entry {
+            uint64_t hash;
+            uint64_t offset;
+            uint64_t size;
+            AssetType type;
+            uint32_t width;     // textures only
+            uint32_t height;
+            uint32_t mipCount;
+        };
+
+        static_assert(sizeof(Header) == 24);
+        static_assert(sizeof(Entry) == 40);
+
+        constexpr uint32_t MipDimension(uint32_t size, uint32_t level) {
+            return std::max(1u, size >> level);
+        }
+
+        constexpr size_t MipBytes(uint32_t width, uint32_t height, uint32_t level) {
+            return static_cast<size_t>(MipDimension(width, level)) * MipDimension(height, level) * 4;
+        }
+    }
+
+    // A cooked asset pack, mapped for the lifetime of the object. Asset data
+    // pointers stay valid until it is destroyed.
+    class AssetPack {
+    public:
+        using Entry = PackFormat::Entry;
+
+        // Throws Core::Exception if the file is missing, truncated or from another version
+        explicit AssetPack(const std::string& path);
+        AssetPack(const AssetPack&) = delete;
+        AssetPack& operator=(const AssetPack&) = delete;
+
+        // nullptr when the pack has no such asset
+        const Entry* Find(std::string_view name) const;
+        const Entry* Find(uint64_t hash) const;
+
+        const uint8_t* GetData(const Entry& entry) const;
+        // Start of a texture's mip level
+        const uint8_t* GetMipData(const Entry& entry, uint32_t level) const;
+
+        size_t GetEntryCount() const;
+        const std::string& GetPath() const;
+
+    private:
+        MappedFile m_file;
+        const Entry* m_entries = nullptr;
+        uint32_t m_entryCount = 0;
+        Util::Logger m_logger;
+    };
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <Util/Log.hpp>
+
+namespace Core {
+    // Watches directory trees for files that were written, created or moved in.
+    // A background thread collects the changes; Poll() hands them to the
+    // callbacks on the caller's thread once a file has been quiet for a moment,
+    // so an editor saving in several writes causes one reload.
+    //
+    // Backed by inotify on Linux. Elsewhere Watch() logs once and does nothing.
+    class FileWatcher {
+    public:
+        // Receives the changed file as '<watched directory>/<relative path>'
+        using Callback = std::function<void(const std::string& path)>;
+
+        static constexpr std::chrono::milliseconds SettleTime{ 100 };
+
+        FileWatcher();
+        ~FileWatcher();
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        // Recursively, including directories created later. Returns false if
+        // the directory can't be watched.
+        bool Watch(const std::string& directory, Callback callback);
+
+        // Runs callbacks for settled changes, returns how many ran
+        size_t Poll();
+
+        static bool IsSupported();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Root {
+            std::string directory;
+            Callback callback;
+        };
+
+        struct Change {
+            size_t root;
+            Clock::time_point lastEvent;
+        };
+
+        Util::Logger m_logger;
+        std::vector<Root> m_roots;
+        std::unordered_map<int, std::pair<std::string, size_t>> m_watches; // descriptor -> directory, root
+        std::unordered_map<std::string, Change> m_changes;
+        std::mutex m_mutex;
+        std::thread m_thread;
+        int m_inotify = -1;
+        int m_wake = -1;
+
+        void AddTree(const std::string& directory, size_t root);
+        void ThreadMain();
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+
+#include <Util/Log.hpp>
+
+namespace Core {
+    // Paces the game loop to a target rate without burning a core. Waits sleep
+    // until shortly before the deadline and spin the rest on the high-resolution
+    // clock; how early to wake is learned from how late the OS wakes us.
+    //
+    // Limit waits after the frame is submitted, like vsync would. JustInTime
+    // waits before it instead: input is sampled and the frame simulated as late
+    // as the measured frame time allows, so it is submitted right at the
+    // deadline with the freshest input. Game thread only.
+    class FramePacer {
+    public:
+        enum class Mode {
+            Unlimited,
+            Limit,
+            JustInTime,
+        };
+
+        struct Stats {
+            double targetHz = 0.0;
+            float frameMs = 0.0f;       // start to start
+            float workMs = 0.0f;        // last frame, excluding waits
+            float estimateMs = 0.0f;    // what JustInTime budgets for the work
+            float waitMs = 0.0f;        // last wait, sleep and spin
+            float spinMs = 0.0f;        // of which spinning
+            float sleepSlackMs = 0.0f;  // how late sleeps currently wake
+            uint64_t late = 0;          // frames that missed their deadline
+        };
+
+        // Headroom JustInTime keeps on top of the work estimate
+        static constexpr uint64_t SafetyMarginNs = 500'000;
+
+        // A rate <= 0 runs unlimited whatever the mode
+        explicit FramePacer(double targetHz, Mode mode = Mode::Limit);
+
+        void SetTargetRate(double hz);
+        double GetTargetRate() const;
+        void SetMode(Mode mode);
+        Mode GetMode() const;
+
+        // First thing in the loop, before polling input. JustInTime waits here.
+        void BeginFrame();
+        // After the frame is submitted. Limit waits here.
+        void EndFrame();
+
+        const Stats& GetStats() const;
+
+        // Refresh rate of the display the window is on, 60 if unknown
+        static double GetRefreshRate(SDL_Window* window);
+
+    private:
+        Mode m_mode;
+        uint64_t m_periodNs = 0;
+        uint64_t m_deadlineNs = 0;      // when the current frame is due, 0: not started
+        uint64_t m_frameStartNs = 0;
+        uint64_t m_workEstimateNs = 0;
+        uint64_t m_sleepSlackNs;
+        Stats m_stats;
+        Util::Logger m_logger;
+
+        void WaitUntil(uint64_t deadlineNs);
+    };
+}
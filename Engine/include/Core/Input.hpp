@@ -2,16 +2,154 @@
 
 #include <SDL3/SDL.h>
 #include <Math/Vector.hpp>
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
 
 namespace Core {
     namespace Input {
+        // One bit per scancode. Chords and mania column layouts are masks of
+        // these, so querying a whole layout is a handful of word operations.
+        struct KeySet {
+            static constexpr size_t Words = SDL_SCANCODE_COUNT / 64;
+            static_assert(SDL_SCANCODE_COUNT % 64 == 0, "scancodes no longer fill whole words");
+
+            std::array<uint64_t, Words> words{};
+
+            constexpr KeySet() = default;
+            constexpr KeySet(std::initializer_list<SDL_Scancode> keys) {
+                for (SDL_Scancode key : keys) {
+                    Set(key);
+                }
+            }
+
+            constexpr void Set(SDL_Scancode key) { words[key >> 6] |= uint64_t{ 1 } << (key & 63); }
+            constexpr void Reset(SDL_Scancode key) { words[key >> 6] &= ~(uint64_t{ 1 } << (key & 63)); }
+            constexpr bool Test(SDL_Scancode key) const { return (words[key >> 6] >> (key & 63)) & 1; }
+
+            // Every key of 'mask' is in this set
+            constexpr bool Contains(const KeySet& mask) const {
+                uint64_t missing = 0;
+                for (size_t i = 0; i < Words; ++i) {
+                    missing |= mask.words[i] & ~words[i];
+                }
+                return missing == 0;
+            }
+            constexpr bool Intersects(const KeySet& mask) const {
+                uint64_t common = 0;
+                for (size_t i = 0; i < Words; ++i) {
+                    common |= mask.words[i] & words[i];
+                }
+                return common != 0;
+            }
+            constexpr int Count() const {
+                int count = 0;
+                for (uint64_t word : words) {
+                    count += std::popcount(word);
+                }
+                return count;
+            }
+            constexpr bool Any() const { return Intersects(*this); }
+
+            constexpr KeySet operator&(const KeySet& rhs) const {
+                KeySet result;
+                for (size_t i = 0; i < Words; ++i) {
+                    result.words[i] = words[i] & rhs.words[i];
+                }
+                return result;
+            }
+            constexpr KeySet operator|(const KeySet& rhs) const {
+                KeySet result;
+                for (size_t i = 0; i < Words; ++i) {
+                    result.words[i] = words[i] | rhs.words[i];
+                }
+                return result;
+            }
+        };
+
+        // Window::Poll drives these: BeginFrame() then every event of the batch.
+        // Game thread only, like everything here.
+        void BeginFrame();
+        void HandleEvent(const SDL_Event& event);
+
         // Mouse input
         Math::Vector2f GetMousePosition();
         bool IsButtonDown(uint8_t button);
 
-        // Keyboard input
+        // Keyboard input. Held state survives key repeat gaps; pressed and
+        // released are this frame's edges, so a tap shorter than a frame
+        // reports both.
+        bool IsDown(SDL_Scancode key);
+        bool WasPressed(SDL_Scancode key);
+        bool WasReleased(SDL_Scancode key);
+        // Every key of 'chord' is held / held with at least one of them new this frame
+        bool IsChordDown(const KeySet& chord);
+        bool WasChordPressed(const KeySet& chord);
+        const KeySet& GetDownKeys();
+        const KeySet& GetPressedKeys();
+        const KeySet& GetReleasedKeys();
+
+        // Most recent key pressed this frame, SDL_SCANCODE_UNKNOWN if none
         SDL_Scancode GetKeyPressed();
         bool IsKeyDown(SDL_Scancode key);
+
+        /* ========================================================== */
+        /* Actions                                                    */
+        /* ========================================================== */
+        // Game-defined actions (lanes, menu keys) with keys and controller buttons
+        // bound to them. An action is down while any of its inputs is.
+        inline constexpr int MaxActions = 64;
+
+        enum class BindingSource : uint8_t {
+            Key,            // SDL_Scancode
+            GamepadButton,  // SDL_GamepadButton, any gamepad
+            JoystickButton, // button index, any joystick that isn't a gamepad
+        };
+
+        struct ActionEvent {
+            int action;
+            bool down;
+            uint64_t timestampNs;   // SDL's event timestamp, what judgement should use
+            SDL_JoystickID device;  // 0 for the keyboard
+        };
+
+        void Bind(BindingSource source, int code, int action);
+        void ClearBindings();
+
+        bool IsActionDown(int action);
+        bool WasActionPressed(int action);
+        bool WasActionReleased(int action);
+        uint64_t GetActionsDown();
+        // This frame's action changes, in order
+        const std::vector<ActionEvent>& GetActionEvents();
+
+        /* ========================================================== */
+        /* Controllers                                                */
+        /* ========================================================== */
+        // Devices are opened when SDL reports them. Rate and jitter come from
+        // the spacing of the device's reports while it is in use.
+        struct DeviceStats {
+            SDL_JoystickID id = 0;
+            std::string name;
+            bool gamepad = false;
+            bool isVirtual = false;
+            uint64_t reports = 0;
+            double rateHz = 0.0;    // 0 until enough reports came in
+            double jitterMs = 0.0;
+        };
+
+        bool IsGamepadButtonDown(SDL_GamepadButton button);
+        std::vector<DeviceStats> GetDeviceStats();
+
+        // SDL virtual joysticks, for tests and for driving input without hardware.
+        // Returns 0 on failure.
+        SDL_JoystickID AttachVirtualJoystick(const char* name, int buttons, int axes = 0);
+        bool SetVirtualButton(SDL_JoystickID device, int button, bool down);
+        bool SetVirtualAxis(SDL_JoystickID device, int axis, int16_t value);
+        void DetachVirtualJoystick(SDL_JoystickID device);
     }
 }
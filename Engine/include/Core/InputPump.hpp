@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <cstdint>
+
+#include <Core/Queue.hpp>
+#include <Util/Log.hpp>
+
+namespace Core {
+    struct InputEvent {
+        SDL_Event event;
+        uint64_t polledNs;      // SDL_GetTicksNS when the pump took it
+    };
+
+    // Pumps SDL events as they arrive instead of once per frame. SDL only allows
+    // that on the thread that initialized video, so Run() takes over the main
+    // thread and the game loop moves to its own; it receives the events,
+    // timestamped, through a lock-free queue (Window::SetInputPump).
+    //
+    // Window changes belong on the main thread, and so do mouse capture, warping
+    // and cursor changes; the game sets up ImGui frames from the pumped events
+    // rather than with ImGui_ImplSDL3_NewFrame. Core::Input still calls
+    // SDL_GetMouseState and opens controllers from the game thread, which SDL
+    // tolerates on X11 and Wayland.
+    class InputPump {
+    public:
+        static constexpr size_t Capacity = 4096;
+
+        InputPump();
+        InputPump(const InputPump&) = delete;
+        InputPump& operator=(const InputPump&) = delete;
+
+        // Main thread, raised to high priority. Returns after Stop().
+        void Run();
+        // Any thread
+        void Stop();
+
+        // Game thread
+        bool Pop(InputEvent& event);
+        bool IsQuitRequested() const;
+        // Events dropped because the game thread fell this far behind
+        uint64_t GetDroppedCount() const;
+
+    private:
+        SpscQueue<InputEvent> m_queue;
+        std::atomic<bool> m_stopping{ false };
+        std::atomic<bool> m_quitRequested{ false };
+        std::atomic<uint64_t> m_dropped{ 0 };
+        Uint32 m_wakeEvent;
+        Util::Logger m_logger;
+    };
+}
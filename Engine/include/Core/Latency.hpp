@@ -0,0 +1,96 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <Util/Log.hpp>
+
+namespace Core {
+    // Fixed-width buckets, cheap to add to and to copy out for display
+    class LatencyHistogram {
+    public:
+        static constexpr uint64_t BucketNs = 250'000;
+        static constexpr size_t BucketCount = 128; // the last one takes everything past 32 ms
+
+        void Add(uint64_t ns);
+        void Clear();
+
+        uint64_t GetCount() const;
+        double GetMeanMs() const;
+        double GetMaxMs() const;
+        // Upper edge of the bucket holding the percentile, 'p' in [0, 1]
+        double GetPercentileMs(double p) const;
+        const std::array<uint32_t, BucketCount>& GetBuckets() const;
+
+    private:
+        std::array<uint32_t, BucketCount> m_buckets{};
+        uint64_t m_count = 0;
+        uint64_t m_totalNs = 0;
+        uint64_t m_maxNs = 0;
+    };
+
+    // Follows input events from the OS to the screen. Each event is stamped
+    // when SDL saw it, when Window::Poll took it, when game logic consumed it,
+    // when the frame reacting to it was submitted and when that frame's swap
+    // returned. A frame dropped by the render thread hands its events to the
+    // next one presented, which is the first to show them.
+    //
+    // Poll and consume stamps come from the game thread, presents from the
+    // render thread.
+    class LatencyTracker {
+    public:
+        enum Stage {
+            Queue,      // event to poll
+            Consume,    // poll to game logic
+            Submit,     // game logic to frame submit
+            Present,    // submit to swap returned
+            Total,      // event to swap returned
+            StageCount,
+        };
+
+        using Histograms = std::array<LatencyHistogram, StageCount>;
+
+        static LatencyTracker& Get();
+        static const char* GetStageName(Stage stage);
+        // Presses, releases and the like; motion is left out, it would drown them
+        static bool IsTracked(const SDL_Event& event);
+
+        void OnPolled(const SDL_Event& event, uint64_t polledNs);
+        // Everything polled so far has been acted on
+        void OnConsumed();
+        // Returns the frame's serial for OnPresented
+        uint64_t OnSubmitted();
+        void OnPresented(uint64_t frameSerial, uint64_t presentedNs);
+
+        Histograms GetHistograms() const;
+        void Reset();
+        // Percentiles of every stage at Info
+        void LogSummary();
+
+    private:
+        struct Sample {
+            uint64_t eventNs;
+            uint64_t polledNs;
+            uint64_t consumedNs;
+            uint64_t submittedNs;
+            uint64_t frame;
+        };
+
+        // Unconsumed events past this are dropped oldest first
+        static constexpr size_t MaxPending = 1024;
+
+        LatencyTracker();
+
+        mutable std::mutex m_mutex;
+        std::vector<Sample> m_polled;
+        std::vector<Sample> m_consumed;
+        std::vector<Sample> m_submitted;
+        uint64_t m_nextFrame = 1;
+        Histograms m_histograms;
+        Util::Logger m_logger;
+    };
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Core {
+    // Read-only view of a whole file through the OS page cache. Pages are faulted
+    // in on first touch, so opening is cheap however big the file is.
+    class MappedFile {
+    public:
+        // Throws Core::Exception if the file can't be opened or mapped
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        const uint8_t* GetData() const;
+        size_t GetSize() const;
+        const std::string& GetPath() const;
+
+    private:
+        std::string m_path;
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+#ifdef _WIN32
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+
+        void Close();
+    };
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace Core {
+    // Producer and consumer state sit on separate lines so the two threads don't
+    // keep stealing one line from each other
+    inline constexpr size_t CacheLineSize = 64;
+
+    // Bounded single-producer single-consumer ring, lock-free and wait-free.
+    // One thread may push and one other thread may pop; the capacity is
+    // rounded up to a power of two.
+    template <typename T>
+    class SpscQueue {
+    public:
+        explicit SpscQueue(size_t capacity)
+            : m_mask(std::bit_ceil(capacity < 2 ? size_t{ 2 } : capacity) - 1),
+            m_slots(std::make_unique<T[]>(m_mask + 1)) {
+        }
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // Producer. False when full, the value is left alone.
+        bool TryPush(const T& value) {
+            return Emplace([&](T& slot) { slot = value; });
+        }
+        bool TryPush(T&& value) {
+            return Emplace([&](T& slot) { slot = std::move(value); });
+        }
+
+        // Consumer. False when empty.
+        bool TryPop(T& value) {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_cachedTail) {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head == m_cachedTail) {
+                    return false;
+                }
+            }
+            value = std::move(m_slots[head & m_mask]);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Exact only on a thread that is neither pushing nor popping at the moment
+        size_t GetSizeApprox() const {
+            return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+        }
+        size_t GetCapacity() const {
+            return m_mask + 1;
+        }
+
+    private:
+        template <typename Assign>
+        bool Emplace(Assign&& assign) {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_cachedHead > m_mask) {
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+                if (tail - m_cachedHead > m_mask) {
+                    return false;
+                }
+            }
+            assign(m_slots[tail & m_mask]);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        const size_t m_mask;
+        const std::unique_ptr<T[]> m_slots;
+
+        // Consumer side, with its last look at the producer's position
+        alignas(CacheLineSize) std::atomic<size_t> m_head{ 0 };
+        size_t m_cachedTail = 0;
+        // Producer side
+        alignas(CacheLineSize) std::atomic<size_t> m_tail{ 0 };
+        size_t m_cachedHead = 0;
+    };
+
+    /* ============================================================== */
+    /* Multiple producers                                             */
+    /* ============================================================== */
+    struct MpscNode {
+        std::atomic<MpscNode*> next{ nullptr };
+    };
+
+    // Unbounded multi-producer single-consumer queue of nodes the caller owns;
+    // T derives from MpscNode and nothing is allocated. Push is wait-free (one
+    // exchange), TryPop is lock-free for the one consumer thread. A node must
+    // stay alive until it has been popped, and may be pushed again after that.
+    template <typename T>
+    class MpscQueue {
+    public:
+        MpscQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Any thread
+        void Push(T* node) {
+            PushNode(node);
+        }
+
+        // Consumer. nullptr when empty, and also while a producer is between its
+        // exchange and linking the node in; that node shows up on a later call.
+        T* TryPop() {
+            MpscNode* tail = m_tail;
+            MpscNode* next = tail->next.load(std::memory_order_acquire);
+            if (tail == &m_stub) {
+                if (!next) {
+                    return nullptr;
+                }
+                m_tail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if (next) {
+                m_tail = next;
+                return static_cast<T*>(tail);
+            }
+
+            if (tail != m_head.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            // Last node: put the stub behind it so it can be handed out
+            PushNode(&m_stub);
+            next = tail->next.load(std::memory_order_acquire);
+            if (next) {
+                m_tail = next;
+                return static_cast<T*>(tail);
+            }
+            return nullptr;
+        }
+
+        // Consumer
+        bool IsEmpty() const {
+            return m_tail == &m_stub && !m_stub.next.load(std::memory_order_acquire);
+        }
+
+    private:
+        void PushNode(MpscNode* node) {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            MpscNode* previous = m_head.exchange(node, std::memory_order_acq_rel);
+            previous->next.store(node, std::memory_order_release);
+        }
+
+        // Producers swap themselves in here
+        alignas(CacheLineSize) std::atomic<MpscNode*> m_head;
+        // Consumer side
+        alignas(CacheLineSize) MpscNode* m_tail;
+        MpscNode m_stub;
+    };
+
+    // Bounded multi-producer multi-consumer ring, lock-free. Each slot carries a
+    // sequence number, so a producer claims a slot with one compare-exchange and
+    // publishes it with one store, and never waits on another producer's copy.
+    // Made for log records and other messages many threads send to one worker.
+    // The capacity is rounded up to a power of two.
+    template <typename T>
+    class MpmcQueue {
+    public:
+        explicit MpmcQueue(size_t capacity)
+            : m_mask(std::bit_ceil(capacity < 2 ? size_t{ 2 } : capacity) - 1),
+            m_slots(std::make_unique<Slot[]>(m_mask + 1)) {
+            for (size_t i = 0; i <= m_mask; ++i) {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        MpmcQueue(const MpmcQueue&) = delete;
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+        // Any thread. False when full, the value is left alone.
+        bool TryPush(const T& value) {
+            return Emplace([&](T& slot) { slot = value; });
+        }
+        bool TryPush(T&& value) {
+            return Emplace([&](T& slot) { slot = std::move(value); });
+        }
+
+        // Any thread. False when empty.
+        bool TryPop(T& value) {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = m_slots[head & m_mask];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                ptrdiff_t lag = static_cast<ptrdiff_t>(sequence - (head + 1));
+                if (lag == 0) {
+                    if (m_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+                        value = std::move(slot.value);
+                        // Free for the producer one lap ahead
+                        slot.sequence.store(head + m_mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (lag < 0) {
+                    return false;
+                }
+                else {
+                    head = m_head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        size_t GetSizeApprox() const {
+            size_t tail = m_tail.load(std::memory_order_acquire);
+            size_t head = m_head.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+        size_t GetCapacity() const {
+            return m_mask + 1;
+        }
+
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence;
+            T value{};
+        };
+
+        template <typename Assign>
+        bool Emplace(Assign&& assign) {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = m_slots[tail & m_mask];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                ptrdiff_t lag = static_cast<ptrdiff_t>(sequence - tail);
+                if (lag == 0) {
+                    if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                        assign(slot.value);
+                        slot.sequence.store(tail + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (lag < 0) {
+                    // Still holds last lap's value
+                    return false;
+                }
+                else {
+                    tail = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        const size_t m_mask;
+        const std::unique_ptr<Slot[]> m_slots;
+
+        alignas(CacheLineSize) std::atomic<size_t> m_head{ 0 };
+        alignas(CacheLineSize) std::atomic<size_t> m_tail{ 0 };
+    };
+}
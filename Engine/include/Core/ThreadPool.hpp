@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core {
+    // Fixed set of worker threads running submitted tasks in FIFO order.
+    // The destructor finishes queued tasks before joining.
+    class ThreadPool {
+    public:
+        // 0 picks a count from the hardware, leaving cores for the game and render threads
+        explicit ThreadPool(size_t threadCount = 0);
+        ~ThreadPool();
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void Submit(std::function<void()> task);
+        // Blocks until the queue is empty and no task is running
+        void WaitIdle();
+        // Runs body(0) .. body(count - 1) across the workers and the calling thread,
+        // returning once all have run. Safe to call from inside a task: the caller
+        // keeps taking indices itself, so it never waits on a busy pool.
+        void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+        size_t GetThreadCount() const;
+
+    private:
+        std::vector<std::thread> m_threads;
+        std::deque<std::function<void()>> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+        size_t m_active = 0;
+        bool m_stopping = false;
+
+        void WorkerMain();
+    };
+}
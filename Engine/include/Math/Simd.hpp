@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Math {
+    namespace Simd {
+        // Thin 4-wide float wrapper. Falls back to plain arrays (which the
+        // compiler can still auto-vectorize) when SSE2 is not available.
+        struct Float4 {
+#ifdef MATH_SIMD_SSE2
+            __m128 v;
+
+            Float4() : v(_mm_setzero_ps()) {}
+            explicit Float4(__m128 value) : v(value) {}
+            explicit Float4(float s) : v(_mm_set1_ps(s)) {}
+            Float4(float a, float b, float c, float d) : v(_mm_setr_ps(a, b, c, d)) {}
+
+            static Float4 Load(const float* p) { return Float4(_mm_loadu_ps(p)); }
+            void Store(float* p) const { _mm_storeu_ps(p, v); }
+
+            Float4 operator+(const Float4& rhs) const { return Float4(_mm_add_ps(v, rhs.v)); }
+            Float4 operator-(const Float4& rhs) const { return Float4(_mm_sub_ps(v, rhs.v)); }
+            Float4 operator*(const Float4& rhs) const { return Float4(_mm_mul_ps(v, rhs.v)); }
+
+            static Float4 Min(const Float4& a, const Float4& b) { return Float4(_mm_min_ps(a.v, b.v)); }
+            static Float4 Max(const Float4& a, const Float4& b) { return Float4(_mm_max_ps(a.v, b.v)); }
+
+            // Comparisons return a per-lane mask
+            Float4 operator<=(const Float4& rhs) const { return Float4(_mm_cmple_ps(v, rhs.v)); }
+            Float4 operator<(const Float4& rhs) const { return Float4(_mm_cmplt_ps(v, rhs.v)); }
+            Float4 operator&(const Float4& rhs) const { return Float4(_mm_and_ps(v, rhs.v)); }
+            Float4 operator|(const Float4& rhs) const { return Float4(_mm_or_ps(v, rhs.v)); }
+
+            // Picks 'a' where mask is set, 'b' otherwise
+            static Float4 Select(const Float4& mask, const Float4& a, const Float4& b) {
+                return Float4(_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)));
+            }
+
+            // One bit per lane, lane 0 in bit 0
+            int Mask() const { return _mm_movemask_ps(v); }
+
+            // Rounds toward zero, valid for |x| < 2^31
+            static Float4 Truncate(const Float4& a) { return Float4(_mm_cvtepi32_ps(_mm_cvttps_epi32(a.v))); }
+            void StoreInt(int32_t* p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvttps_epi32(v)); }
+#else
+            float v[4];
+
+            Float4() : v{ 0.0f, 0.0f, 0.0f, 0.0f } {}
+            explicit Float4(float s) : v{ s, s, s, s } {}
+            Float4(float a, float b, float c, float d) : v{ a, b, c, d } {}
+
+            static Float4 Load(const float* p) { return Float4(p[0], p[1], p[2], p[3]); }
+            void Store(float* p) const { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+
+            Float4 operator+(const Float4& rhs) const { return Float4(v[0] + rhs.v[0], v[1] + rhs.v[1], v[2] + rhs.v[2], v[3] + rhs.v[3]); }
+            Float4 operator-(const Float4& rhs) const { return Float4(v[0] - rhs.v[0], v[1] - rhs.v[1], v[2] - rhs.v[2], v[3] - rhs.v[3]); }
+            Float4 operator*(const Float4& rhs) const { return Float4(v[0] * rhs.v[0], v[1] * rhs.v[1], v[2] * rhs.v[2], v[3] * rhs.v[3]); }
+
+            static Float4 Min(const Float4& a, const Float4& b) {
+                Float4 r;
+                for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+                return r;
+            }
+            static Float4 Max(const Float4& a, const Float4& b) {
+                Float4 r;
+                for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+                return r;
+            }
+
+            Float4 operator<=(const Float4& rhs) const { return Compare(*this, rhs, [](float a, float b) { return a <= b; }); }
+            Float4 operator<(const Float4& rhs) const { return Compare(*this, rhs, [](float a, float b) { return a < b; }); }
+            Float4 operator&(const Float4& rhs) const { return Bitwise(*this, rhs, [](uint32_t a, uint32_t b) { return a & b; }); }
+            Float4 operator|(const Float4& rhs) const { return Bitwise(*this, rhs, [](uint32_t a, uint32_t b) { return a | b; }); }
+
+            static Float4 Select(const Float4& mask, const Float4& a, const Float4& b) {
+                Float4 r;
+                for (int i = 0; i < 4; ++i) r.v[i] = (Bits(mask.v[i]) != 0) ? a.v[i] : b.v[i];
+                return r;
+            }
+
+            int Mask() const {
+                int m = 0;
+                for (int i = 0; i < 4; ++i) m |= static_cast<int>(Bits(v[i]) >> 31) << i;
+                return m;
+            }
+
+            static Float4 Truncate(const Float4& a) {
+                Float4 r;
+                for (int i = 0; i < 4; ++i) r.v[i] = static_cast<float>(static_cast<int32_t>(a.v[i]));
+                return r;
+            }
+            void StoreInt(int32_t* p) const { for (int i = 0; i < 4; ++i) p[i] = static_cast<int32_t>(v[i]); }
+
+        private:
+            static uint32_t Bits(float f) { uint32_t u; std::memcpy(&u, &f, sizeof(u)); return u; }
+            static float FromBits(uint32_t u) { float f; std::memcpy(&f, &u, sizeof(f)); return f; }
+
+            template<typename Fn>
+            static Float4 Compare(const Float4& a, const Float4& b, Fn fn) {
+                Float4 r;
+                for (int i = 0; i < 4; ++i) r.v[i] = FromBits(fn(a.v[i], b.v[i]) ? 0xFFFFFFFFu : 0u);
+                return r;
+            }
+
+            template<typename Fn>
+            static Float4 Bitwise(const Float4& a, const Float4& b, Fn fn) {
+                Float4 r;
+                for (int i = 0; i < 4; ++i) r.v[i] = FromBits(fn(Bits(a.v[i]), Bits(b.v[i])));
+                return r;
+            }
+#endif
+        };
+    }
+}
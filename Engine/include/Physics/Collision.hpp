@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Math/Vector.hpp>
+
+namespace Physics {
+    struct AABB {
+        Math::Vector2f min;
+        Math::Vector2f max;
+
+        AABB() = default;
+        AABB(const Math::Vector2f& min, const Math::Vector2f& max);
+
+        // Box centered at 'center', matching how Draw::TexturedQuad places sprites
+        static AABB FromCenter(const Math::Vector2f& center, const Math::Vector2f& size);
+
+        Math::Vector2f Center() const;
+        Math::Vector2f Size() const;
+    };
+
+    struct Circle {
+        Math::Vector2f center;
+        float radius = 0.0f;
+
+        Circle() = default;
+        Circle(const Math::Vector2f& center, float radius);
+
+        AABB Bounds() const;
+    };
+
+    bool Contains(const AABB& box, const Math::Vector2f& point);
+    bool Contains(const Circle& circle, const Math::Vector2f& point);
+
+    bool Intersects(const AABB& a, const AABB& b);
+    bool Intersects(const Circle& a, const Circle& b);
+    bool Intersects(const AABB& box, const Circle& circle);
+}
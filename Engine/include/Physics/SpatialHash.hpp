@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <Math/Vector.hpp>
+#include <Physics/Collision.hpp>
+
+namespace Physics {
+    using BodyID = uint32_t;
+
+    struct BodyPair {
+        BodyID a;
+        BodyID b;
+    };
+
+    // Uniform grid broad phase. Bodies are only re-bucketed when the set of
+    // cells they cover changes, so moving a body inside its cells is cheap.
+    // Insert and Update throw on non-finite bounds and on bodies covering more
+    // than MaxCellsPerBody cells; coordinates past the grid edge clamp to it.
+    class SpatialHash {
+    public:
+        static constexpr int64_t MaxCellsPerBody = 1 << 16;
+
+        explicit SpatialHash(float cellSize = 64.0f);
+
+        BodyID Insert(const AABB& box);
+        BodyID Insert(const Circle& circle);
+        void Update(BodyID id, const AABB& box);
+        void Update(BodyID id, const Circle& circle);
+        void Remove(BodyID id);
+        void Clear();
+
+        // Point queries only visit the cell containing the point
+        void QueryPoint(const Math::Vector2f& point, std::vector<BodyID>& out) const;
+        // Boxes larger than the occupied grid walk the occupied cells instead
+        void QueryBox(const AABB& box, std::vector<BodyID>& out) const;
+        // Topmost body under 'point': the one inserted last. IDs are reused
+        // after Remove, so they say nothing about the order.
+        std::optional<BodyID> Pick(const Math::Vector2f& point) const;
+
+        // Broad phase: every pair sharing a cell, each reported once
+        void FindPairs(std::vector<BodyPair>& out) const;
+        // Narrow phase: drops pairs whose shapes don't intersect, 4 pairs per SIMD step
+        void FilterPairs(std::vector<BodyPair>& pairs) const;
+        // FindPairs + FilterPairs, replacing the contents of 'out'
+        void Collide(std::vector<BodyPair>& out) const;
+
+        AABB GetBounds(BodyID id) const;
+        bool IsValid(BodyID id) const;
+        size_t GetBodyCount() const;
+        size_t GetCellCount() const;
+        float GetCellSize() const;
+
+    private:
+        enum class Shape : uint8_t {
+            None = 0,
+            Box,
+            Circle,
+        };
+
+        struct CellRange {
+            int32_t minX = 0;
+            int32_t minY = 0;
+            int32_t maxX = -1;
+            int32_t maxY = -1;
+
+            bool operator==(const CellRange& rhs) const = default;
+            int64_t Count() const;
+        };
+
+        float m_cellSize;
+        float m_invCellSize;
+
+        // Body data is kept as SoA so the narrow phase can load 4 bodies at once
+        std::vector<float> m_minX;
+        std::vector<float> m_minY;
+        std::vector<float> m_maxX;
+        std::vector<float> m_maxY;
+        std::vector<float> m_radius;
+        std::vector<Shape> m_shape;
+        std::vector<CellRange> m_ranges;
+        // Insertion sequence, what Pick means by topmost
+        std::vector<uint64_t> m_order;
+        std::vector<BodyID> m_freeList;
+        size_t m_bodyCount = 0;
+        uint64_t m_nextOrder = 0;
+
+        std::unordered_map<uint64_t, std::vector<BodyID>> m_cells;
+
+        BodyID Allocate();
+        void SetBody(BodyID id, Shape shape, const AABB& bounds, float radius);
+        void CheckBounds(const AABB& bounds, const char* caller) const;
+        CellRange ComputeRange(const AABB& bounds) const;
+        int32_t ToCell(float coord) const;
+        void AddToCells(BodyID id, const CellRange& range);
+        void RemoveFromCells(BodyID id, const CellRange& range);
+        bool ContainsPoint(BodyID id, const Math::Vector2f& point) const;
+        bool IntersectsScalar(BodyID a, BodyID b) const;
+
+        static uint64_t CellKey(int32_t x, int32_t y);
+    };
+}
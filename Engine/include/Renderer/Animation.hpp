@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <SDL3/SDL_opengl.h>
+
+#include <Math/Vector.hpp>
+#include <Renderer/SpriteBatch.hpp>
+#include <Renderer/TextureManager.hpp>
+
+namespace Renderer {
+    // Frames of a sprite sheet texture, in row-major order
+    struct SpriteSheet {
+        GLuint texture = 0;
+        std::vector<UVRect> frames;
+
+        // Splits the texture into a grid of 'frameSize' cells. A frameCount of 0 uses every cell.
+        static SpriteSheet FromGrid(const TextureData& texture, const Math::Vector2f& frameSize, uint32_t frameCount = 0);
+    };
+
+    using ClipID = uint32_t;
+    using AnimationID = uint32_t;
+
+    // Plays clips for many instances at once. Playback state lives in SoA arrays
+    // so Update() advances 4 instances per SIMD step, and Emit() writes quads
+    // straight into a SpriteBatch without any per-instance dispatch.
+    class AnimationSystem {
+    public:
+        AnimationSystem();
+
+        ClipID AddClip(const SpriteSheet& sheet, uint32_t firstFrame, uint32_t frameCount, float fps, bool loop);
+
+        // 'speed' scales the clip's fps and must not be negative
+        AnimationID Play(ClipID clip, const Math::Vector2f& pos, const Math::Vector2f& size,
+            float speed = 1.0f, uint32_t color = SpriteBatch::White);
+        void Stop(AnimationID id);
+        bool IsPlaying(AnimationID id) const;
+        void SetPosition(AnimationID id, const Math::Vector2f& pos);
+        void Clear();
+
+        // Advances every instance; finished one-shot clips are removed
+        void Update(float deltaTime);
+        void Emit(SpriteBatch& batch) const;
+
+        size_t GetInstanceCount() const;
+
+    private:
+        struct Clip {
+            GLuint texture;
+            uint32_t firstUV;
+            uint32_t frameCount;
+            float fps;
+            bool loop;
+        };
+
+        static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+        std::vector<Clip> m_clips;
+        std::vector<UVRect> m_frameUVs;
+
+        // Per-instance playback state (SoA, dense, swap-removed)
+        std::vector<float> m_time;
+        std::vector<float> m_speed;
+        std::vector<float> m_fps;
+        std::vector<float> m_frameCount;
+        std::vector<float> m_invFrameCount;
+        std::vector<float> m_duration;
+        std::vector<float> m_loop;
+        std::vector<int32_t> m_frame;
+        std::vector<uint8_t> m_finished;
+        std::vector<ClipID> m_clip;
+        std::vector<float> m_posX;
+        std::vector<float> m_posY;
+        std::vector<float> m_sizeX;
+        std::vector<float> m_sizeY;
+        std::vector<uint32_t> m_color;
+
+        // Stable handles on top of the dense arrays
+        std::vector<uint32_t> m_handleToIndex;
+        std::vector<AnimationID> m_indexToHandle;
+        std::vector<AnimationID> m_freeHandles;
+
+        void RemoveAt(uint32_t index);
+    };
+}
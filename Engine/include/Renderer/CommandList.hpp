@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <SDL3/SDL_opengl.h>
+
+#include <Math/Vector.hpp>
+#include <Renderer/Shader.hpp>
+#include <Renderer/SpriteBatch.hpp>
+
+namespace Renderer {
+    // Where a draw lands in the frame. Commands are ordered by layer, then opaque
+    // before translucent. Opaque draws are free to reorder by shader and texture;
+    // translucent ones go by depth and keep record order within a depth, so
+    // painter's order holds.
+    struct DrawParams {
+        uint8_t layer = 0;
+        uint32_t depth = 0;           // 23 bits used, higher draws later
+        bool translucent = true;      // false disables blending
+        const Shader* shader = nullptr; // nullptr: built-in sprite shader
+    };
+
+    // A frame's worth of draw commands recorded without touching GL. The game
+    // thread fills one, Sort() orders it by 64-bit key, and the render thread
+    // replays it with Execute(). Recorded vertices never move: a replayed call
+    // draws a list of spans out of them.
+    class CommandList {
+    public:
+        enum class CommandType : uint8_t {
+            Clear,
+            Sprites,
+        };
+
+        // Kept small, Sort() reads these in key order
+        struct Command {
+            SpriteBatch::Range range;   // Sprites: indexes into the recorded vertices
+            const Shader* shader;
+            uint32_t clearIndex;        // Clear: index into the clear colors
+            CommandType type;
+            bool translucent;
+        };
+
+        // One call on replay: a clear, or spans [firstSpan, firstSpan + spanCount)
+        // of GetSpans() drawn with the same texture, shader and blending
+        struct Call {
+            GLuint texture;
+            const Shader* shader;
+            uint32_t clearIndex;
+            uint32_t firstSpan;
+            uint32_t spanCount;
+            CommandType type;
+            bool translucent;
+        };
+
+        // Buffers SortKeys reuses between frames
+        struct SortScratch {
+            std::vector<uint32_t> digits;
+            std::vector<uint32_t> indices;
+        };
+
+        explicit CommandList(size_t reserveSprites = 1024);
+
+        void Reset();
+
+        // Clears sort ahead of every draw in the frame
+        void Clear(const Math::Vector4f& color);
+        void TexturedQuad(GLuint textureID, const Math::Vector2f& size, const Math::Vector2f& pos,
+            const DrawParams& params = DrawParams{});
+        // Every range of the batch shares 'params'; opaque ranges may reorder by
+        // texture, translucent ones keep batch order
+        void Sprites(const SpriteBatch& batch, const DrawParams& params = DrawParams{});
+
+        // Orders commands by key and merges neighbours that can share a draw call.
+        // Cheap to call again when nothing was recorded since.
+        void Sort();
+
+        // The key sort on its own: fills 'order' with the indices of 'keys' in
+        // ascending key order. Stable, so equal keys keep call order.
+        static void SortKeys(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, SortScratch& scratch);
+
+        // Render thread only, sorts first if needed
+        void Execute();
+
+        static uint64_t MakeSortKey(const DrawParams& params, GLuint texture);
+
+        const std::vector<Command>& GetCommands() const;
+        // Valid after Sort()
+        const std::vector<Call>& GetCalls() const;
+        const std::vector<SpriteBatch::Range>& GetSpans() const;
+        size_t GetDrawCallCount() const;
+        bool IsEmpty() const;
+
+    private:
+        // Recorded, in call order
+        std::vector<Command> m_commands;
+        std::vector<uint64_t> m_keys;
+        std::vector<SpriteVertex> m_vertices;
+        std::vector<Math::Vector4f> m_clearColors;
+
+        // Sorted output: calls in replay order, each naming a run of spans.
+        // Spans that touch in the recorded vertices are joined.
+        std::vector<uint32_t> m_order;
+        SortScratch m_sortScratch;
+        std::vector<Call> m_calls;
+        std::vector<SpriteBatch::Range> m_spans;
+        bool m_isSorted = true;
+
+        void Push(const Command& command, uint64_t key);
+    };
+}
@@ -1,13 +1,27 @@
 #pragma once
 
+#include <cstddef>
 #include <SDL3/SDL_opengl.h>
 #include <Core/Exceptions.hpp>
 #include <Math/Vector.hpp>
+#include <Renderer/SpriteBatch.hpp>
+#include <Renderer/Shader.hpp>
 
 namespace Renderer {
     namespace Draw {
+        // Needs a core-profile context with GL::Load() done (Window takes care of both)
         void Init(const Math::Vector2f& screenSize = Math::Vector2f(800.0f, 600.0f), bool vsync = true);
+        void Shutdown();
+        ShaderLibrary& GetShaderLibrary();
         void Clear(Math::Vector4f color);
         void TexturedQuad(GLuint textureID, const Math::Vector2f& size, const Math::Vector2f& pos);
+        void Batch(const SpriteBatch& batch);
+
+        // Lower-level pair used by command list replay: upload once, then draw any
+        // number of ranges that index into the uploaded vertices
+        void UploadVertices(const SpriteVertex* vertices, size_t count);
+        void DrawRange(const SpriteBatch::Range& range, const Shader* shader = nullptr, bool blend = true);
+        // One call for 'count' ranges that share the first range's texture
+        void DrawRanges(const SpriteBatch::Range* ranges, size_t count, const Shader* shader = nullptr, bool blend = true);
     }
 }
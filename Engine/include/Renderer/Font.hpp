@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <SDL3/SDL_opengl.h>
+
+#include <Math/Vector.hpp>
+#include <Renderer/SpriteBatch.hpp>
+#include <Renderer/TextureManager.hpp>
+#include <Util/Log.hpp>
+
+namespace Renderer {
+    // Printable ASCII baked into a single atlas texture owned by a TextureManager.
+    // Laid-out strings are cached, so drawing the same text again only copies quads.
+    // The cache keeps the most recently used runs, up to its capacity.
+    class Font {
+    public:
+        struct Glyph {
+            UVRect uv;
+            float x0, y0, x1, y1; // quad relative to the pen position on the baseline
+            float advance;
+        };
+
+        struct GlyphQuad {
+            float x0, y0, x1, y1; // relative to the top-left of the text
+            UVRect uv;
+        };
+
+        struct TextRun {
+            std::vector<GlyphQuad> quads;
+            float width = 0.0f;
+        };
+
+        static constexpr int FirstChar = 32;
+        static constexpr int CharCount = 95;
+        static constexpr size_t DefaultRunCapacity = 512;
+
+        Font(TextureManager& textures, const std::string& name, const std::string& ttfPath, float pixelHeight);
+
+        // Layout for 'text', computed on first use and cached afterwards. Valid
+        // until the next Shape, which may evict it.
+        const TextRun& Shape(std::string_view text);
+
+        // 'pos' is the top-left corner of the first line
+        void Draw(SpriteBatch& batch, std::string_view text, const Math::Vector2f& pos, uint32_t color = SpriteBatch::White);
+        // Formats into a stack buffer and emits glyphs directly, without allocating or shaping
+        void DrawNumber(SpriteBatch& batch, int64_t value, const Math::Vector2f& pos, uint32_t color = SpriteBatch::White);
+
+        float Measure(std::string_view text);
+        float GetLineHeight() const;
+        float GetPixelHeight() const;
+        GLuint GetTexture() const;
+        size_t GetCachedRunCount() const;
+        // Least recently used runs are dropped past 'runs', at least 1
+        void SetRunCapacity(size_t runs);
+        size_t GetRunCapacity() const;
+        void ClearCache();
+
+    private:
+        using RunList = std::list<std::pair<std::string, TextRun>>;
+
+        Util::Logger m_logger;
+        GLuint m_texture = 0;
+        float m_pixelHeight;
+        float m_ascent = 0.0f;
+        float m_lineHeight = 0.0f;
+        std::array<Glyph, CharCount> m_glyphs{};
+        // Most recently used first; the index keys view the strings in the list nodes
+        RunList m_runs;
+        std::unordered_map<std::string_view, RunList::iterator> m_runIndex;
+        size_t m_runCapacity = DefaultRunCapacity;
+
+        const Glyph& GetGlyph(char c) const;
+        void EmitGlyphs(SpriteBatch& batch, std::string_view text, const Math::Vector2f& pos, uint32_t color) const;
+    };
+}
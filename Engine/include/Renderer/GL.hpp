@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SDL3/SDL_opengl.h>
+
+// Core-profile entry points beyond GL 1.1 are loaded at runtime through
+// SDL_GL_GetProcAddress. They live in Renderer::GL so they never clash with
+// whatever the system GL headers or libraries export.
+#define RENDERER_GL_FUNCTIONS(X) \
+    X(PFNGLACTIVETEXTUREPROC, ActiveTexture) \
+    X(PFNGLCREATESHADERPROC, CreateShader) \
+    X(PFNGLSHADERSOURCEPROC, ShaderSource) \
+    X(PFNGLCOMPILESHADERPROC, CompileShader) \
+    X(PFNGLGETSHADERIVPROC, GetShaderiv) \
+    X(PFNGLGETSHADERINFOLOGPROC, GetShaderInfoLog) \
+    X(PFNGLDELETESHADERPROC, DeleteShader) \
+    X(PFNGLCREATEPROGRAMPROC, CreateProgram) \
+    X(PFNGLATTACHSHADERPROC, AttachShader) \
+    X(PFNGLLINKPROGRAMPROC, LinkProgram) \
+    X(PFNGLGETPROGRAMIVPROC, GetProgramiv) \
+    X(PFNGLGETPROGRAMINFOLOGPROC, GetProgramInfoLog) \
+    X(PFNGLDELETEPROGRAMPROC, DeleteProgram) \
+    X(PFNGLUSEPROGRAMPROC, UseProgram) \
+    X(PFNGLGETUNIFORMLOCATIONPROC, GetUniformLocation) \
+    X(PFNGLUNIFORM1IPROC, Uniform1i) \
+    X(PFNGLGETUNIFORMBLOCKINDEXPROC, GetUniformBlockIndex) \
+    X(PFNGLUNIFORMBLOCKBINDINGPROC, UniformBlockBinding) \
+    X(PFNGLGENBUFFERSPROC, GenBuffers) \
+    X(PFNGLDELETEBUFFERSPROC, DeleteBuffers) \
+    X(PFNGLBINDBUFFERPROC, BindBuffer) \
+    X(PFNGLBINDBUFFERBASEPROC, BindBufferBase) \
+    X(PFNGLBUFFERDATAPROC, BufferData) \
+    X(PFNGLBUFFERSUBDATAPROC, BufferSubData) \
+    X(PFNGLGENVERTEXARRAYSPROC, GenVertexArrays) \
+    X(PFNGLDELETEVERTEXARRAYSPROC, DeleteVertexArrays) \
+    X(PFNGLBINDVERTEXARRAYPROC, BindVertexArray) \
+    X(PFNGLVERTEXATTRIBPOINTERPROC, VertexAttribPointer) \
+    X(PFNGLENABLEVERTEXATTRIBARRAYPROC, EnableVertexAttribArray) \
+    X(PFNGLMULTIDRAWELEMENTSPROC, MultiDrawElements) \
+    X(PFNGLMAPBUFFERRANGEPROC, MapBufferRange) \
+    X(PFNGLUNMAPBUFFERPROC, UnmapBuffer) \
+    X(PFNGLFENCESYNCPROC, FenceSync) \
+    X(PFNGLCLIENTWAITSYNCPROC, ClientWaitSync) \
+    X(PFNGLDELETESYNCPROC, DeleteSync) \
+    X(PFNGLGETSTRINGIPROC, GetStringi) \
+    X(PFNGLGENERATEMIPMAPPROC, GenerateMipmap)
+
+// Extension entry points, null when the driver doesn't offer them
+#define RENDERER_GL_OPTIONAL_FUNCTIONS(X) \
+    X(PFNGLBUFFERSTORAGEPROC, BufferStorage)
+
+namespace Renderer {
+    namespace GL {
+#define RENDERER_GL_DECLARE(type, name) extern type name;
+        RENDERER_GL_FUNCTIONS(RENDERER_GL_DECLARE)
+        RENDERER_GL_OPTIONAL_FUNCTIONS(RENDERER_GL_DECLARE)
+#undef RENDERER_GL_DECLARE
+
+        // Needs a current context. Returns false if any required entry point is missing.
+        bool Load();
+        bool IsLoaded();
+        bool HasExtension(const char* name);
+        // Immutable storage that can stay mapped (GL 4.4 / ARB_buffer_storage)
+        bool HasBufferStorage();
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Renderer {
+    // CPU mip chains for RGBA8 images. A chain is every level back to back,
+    // largest first, rows tightly packed; level n is max(1, size >> n) wide.
+    namespace Mipmap {
+        // Levels down to 1x1
+        uint32_t LevelCount(uint32_t width, uint32_t height);
+        size_t LevelBytes(uint32_t width, uint32_t height, uint32_t level);
+        size_t ChainBytes(uint32_t width, uint32_t height, uint32_t levels);
+        // First level whose larger side is at most 'maxSize'
+        uint32_t FirstLevelWithin(uint32_t width, uint32_t height, uint32_t maxSize);
+
+        // 2x2 box filter into the next level; odd edges repeat their last row/column
+        void Downsample(const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination);
+        // 'chain' holds level 0 and room for 'levels'; fills in the rest
+        void Build(uint8_t* chain, uint32_t width, uint32_t height, uint32_t levels);
+    }
+}
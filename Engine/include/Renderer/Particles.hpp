@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <SDL3/SDL_opengl.h>
+
+#include <Math/Vector.hpp>
+#include <Renderer/SpriteBatch.hpp>
+
+namespace Renderer {
+    struct EmitterSettings {
+        GLuint texture = 0;
+        Math::Vector2f size{ 8.0f, 8.0f };
+        float lifetime = 0.5f;          // seconds
+        float lifetimeVariance = 0.2f;  // +/- fraction of lifetime
+        float speedMin = 100.0f;        // pixels per second
+        float speedMax = 300.0f;
+        float direction = 0.0f;         // radians, 0 points right
+        float spread = 6.2831853f;      // full circle by default
+        Math::Vector2f gravity{ 0.0f, 0.0f };
+        float drag = 0.0f;              // fraction of velocity lost per second
+        uint32_t color = SpriteBatch::White;
+    };
+
+    // Fixed-capacity particle pool. Particles live in SoA arrays and dead ones
+    // are swap-removed, so the live range is always dense. Update() does not
+    // touch GL and can be run headless.
+    class ParticleEmitter {
+    public:
+        explicit ParticleEmitter(size_t capacity, const EmitterSettings& settings = EmitterSettings{});
+
+        // Spawns up to 'count' particles at 'pos'; returns how many fit in the pool
+        size_t Burst(const Math::Vector2f& pos, size_t count);
+        void Update(float deltaTime);
+        // Writes every live particle into 'batch' as one texture run
+        void Emit(SpriteBatch& batch) const;
+        void Clear();
+
+        EmitterSettings& GetSettings();
+        const EmitterSettings& GetSettings() const;
+        size_t GetCount() const;
+        size_t GetCapacity() const;
+
+    private:
+        EmitterSettings m_settings;
+        size_t m_capacity;
+        size_t m_count = 0;
+        uint32_t m_rng = 0x9E3779B9u;
+
+        std::vector<float> m_posX;
+        std::vector<float> m_posY;
+        std::vector<float> m_velX;
+        std::vector<float> m_velY;
+        std::vector<float> m_life;
+        std::vector<float> m_invLifetime;
+        std::vector<float> m_alpha;
+
+        float NextRandom();
+    };
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <imgui.h>
+
+#include <Renderer/CommandList.hpp>
+#include <Renderer/Window.hpp>
+#include <Util/Log.hpp>
+
+namespace Renderer {
+    // Owns the window's GL context while running. The game thread records a
+    // CommandList per frame and submits it; the render thread replays the most
+    // recent one and swaps. Frames are triple-buffered: submitting never blocks,
+    // a frame the render thread hasn't picked up yet is replaced (and counted as
+    // dropped), so simulation can run faster than the display.
+    class RenderThread {
+    public:
+        struct Stats {
+            uint64_t submitted = 0;
+            uint64_t presented = 0;
+            uint64_t dropped = 0;
+            float renderMs = 0.0f;     // replay + swap of the last presented frame
+            uint32_t drawCalls = 0;    // sprite draw calls of the last presented frame
+            uint32_t glIssued = 0;     // StateCache counters of the last presented frame
+            uint32_t glSkipped = 0;
+        };
+
+        // Everything GL must be set up (Draw::Init, textures, ImGui backend) before Start()
+        explicit RenderThread(Window& window);
+        ~RenderThread();
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        // Hands the GL context to the render thread / takes it back on the caller
+        void Start();
+        void Stop();
+        bool IsRunning() const;
+
+        // Runs on the render thread ahead of every frame with the list about to be
+        // replayed (texture upload pumps and the like). Set before Start().
+        void SetFrameCallback(std::function<void(CommandList&)> callback);
+
+        // Game thread: the list to record this frame into, already reset
+        CommandList& BeginFrame();
+        // Game thread: publishes the recorded list, with an optional ImGui frame.
+        // Rethrows anything the render thread failed with.
+        void Submit(ImDrawData* ui = nullptr);
+
+        // Runs 'task' with the GL context current and waits for it. Use this for
+        // GL work (texture uploads etc.) after Start(); runs inline when stopped.
+        void Invoke(const std::function<void()>& task);
+
+        Stats GetStats() const;
+
+    private:
+        struct Frame {
+            CommandList commands;
+            ImDrawData ui;
+            bool hasUi = false;
+            uint64_t latencySerial = 0;
+
+            ~Frame();
+            void SnapshotUi(ImDrawData* source);
+            void ReleaseUi();
+        };
+
+        struct Task {
+            const std::function<void()>* function;
+            std::exception_ptr* error;
+            bool* done;
+        };
+
+        Window& m_window;
+        Util::Logger m_logger;
+        std::thread m_thread;
+        std::function<void(CommandList&)> m_frameCallback;
+
+        // Slot roles rotate: the game thread writes one, one waits for pickup, the render thread reads one
+        std::array<Frame, 3> m_frames;
+        int m_writeIndex = 0;
+        int m_readyIndex = 1;
+        int m_readIndex = 2;
+        bool m_hasReady = false;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_taskDone;
+        std::deque<Task> m_tasks;
+        bool m_running = false;        // game thread only
+        bool m_stopRequested = false;
+        bool m_threadExited = false;
+        std::exception_ptr m_error;
+        Stats m_stats;
+
+        void ThreadMain();
+        void RenderFrame(Frame& frame);
+        void UpdateUiTextures(ImDrawData* ui);
+    };
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <SDL3/SDL_opengl.h>
+
+#include <Util/Log.hpp>
+
+namespace Renderer {
+    class Shader {
+    private:
+        GLuint m_program = 0;
+        std::string m_name;
+
+        static GLuint Compile(const std::string& name, GLenum type, const char* source);
+
+    public:
+        // Throws Core::Exception with the driver's info log on failure
+        Shader(const std::string& name, const char* vertexSource, const char* fragmentSource);
+        ~Shader();
+        Shader(const Shader&) = delete;
+        Shader& operator=(const Shader&) = delete;
+
+        GLuint GetProgram() const;
+        const std::string& GetName() const;
+        GLint GetUniformLocation(const char* uniform) const;
+        // Binds a std140 uniform block to a fixed binding point; ignored if the shader doesn't use it
+        void BindUniformBlock(const char* block, GLuint binding) const;
+    };
+
+    class ShaderLibrary {
+    private:
+        std::unordered_map<std::string, std::unique_ptr<Shader>> m_shaders;
+        Util::Logger m_logger;
+
+    public:
+        // Binding point of the 'Camera' uniform block shared by all shaders
+        static constexpr GLuint CameraBinding = 0;
+
+        ShaderLibrary();
+
+        Shader* Add(const std::string& name, const char* vertexSource, const char* fragmentSource);
+        Shader* Get(const std::string& name) const;
+        void LoadBuiltins();
+        void Clear();
+    };
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <SDL3/SDL_opengl.h>
+
+#include <Math/Vector.hpp>
+
+namespace Renderer {
+    // Texture coordinates in image space: (0, 0) is the top-left pixel
+    struct UVRect {
+        float u0 = 0.0f;
+        float v0 = 0.0f;
+        float u1 = 1.0f;
+        float v1 = 1.0f;
+    };
+
+    struct SpriteVertex {
+        float x;
+        float y;
+        float u;
+        float v;
+        uint32_t color; // RGBA8, R in the lowest byte
+    };
+
+    // CPU-side quad list. Consecutive sprites sharing a texture are merged into
+    // one range, and Draw::Batch issues a single draw call per range.
+    class SpriteBatch {
+    public:
+        struct Range {
+            GLuint texture;
+            uint32_t firstVertex;
+            uint32_t vertexCount;
+        };
+
+        static constexpr uint32_t White = 0xFFFFFFFFu;
+
+        explicit SpriteBatch(size_t reserveSprites = 1024);
+
+        void Clear();
+
+        // Quad centered at 'pos', like Draw::TexturedQuad
+        void Draw(GLuint texture, const Math::Vector2f& pos, const Math::Vector2f& size,
+            const UVRect& uv = UVRect{}, uint32_t color = White);
+
+        // Room for 'spriteCount' quads (4 vertices each) to be written in place
+        SpriteVertex* Reserve(GLuint texture, size_t spriteCount);
+
+        static void WriteQuad(SpriteVertex* out, float x0, float y0, float x1, float y1,
+            const UVRect& uv, uint32_t color);
+
+        const std::vector<SpriteVertex>& GetVertices() const;
+        const std::vector<Range>& GetRanges() const;
+        size_t GetSpriteCount() const;
+
+    private:
+        std::vector<SpriteVertex> m_vertices;
+        std::vector<Range> m_ranges;
+    };
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <SDL3/SDL_opengl.h>
+
+namespace Renderer {
+    // Shadow copy of the GL state the engine touches. Every setter compares
+    // against the cached value first and only calls into the driver on a change.
+    // Code that changes GL state behind its back must call Invalidate().
+    class StateCache {
+    public:
+        struct Stats {
+            uint32_t issued = 0;
+            uint32_t skipped = 0;
+        };
+
+        static constexpr int MaxTextureUnits = 16;
+
+        static StateCache& Get();
+
+        void ActiveTexture(GLenum unit);
+        void BindTexture(GLuint texture);               // on the active unit
+        void BindTexture(GLenum unit, GLuint texture);
+        void UseProgram(GLuint program);
+        void BindVertexArray(GLuint vao);
+        void BindBuffer(GLenum target, GLuint buffer);
+        void Enable(GLenum cap);
+        void Disable(GLenum cap);
+        void BlendFunc(GLenum src, GLenum dst);
+        void ClearColor(float r, float g, float b, float a);
+
+        // Keep the cache in sync when objects die (GL rebinds them to 0)
+        void OnTextureDeleted(GLuint texture);
+        void OnBufferDeleted(GLuint buffer);
+        void OnVertexArrayDeleted(GLuint vao);
+
+        // Forget everything, the next call of each kind goes to the driver
+        void Invalidate();
+
+        // Call once per frame: publishes this frame's counters and starts new ones
+        void NewFrame();
+        const Stats& GetFrameStats() const;
+
+    private:
+        static constexpr GLuint Unknown = 0xFFFFFFFFu;
+
+        enum BufferSlot {
+            ArrayBuffer = 0,
+            ElementBuffer,
+            UniformBuffer,
+            PixelUnpackBuffer,
+            PixelPackBuffer,
+            BufferSlotCount,
+        };
+
+        enum CapSlot {
+            CapBlend = 0,
+            CapDepthTest,
+            CapScissorTest,
+            CapCullFace,
+            CapSlotCount,
+        };
+
+        GLenum m_activeUnit = Unknown;
+        std::array<GLuint, MaxTextureUnits> m_textures{};
+        GLuint m_program = Unknown;
+        GLuint m_vao = Unknown;
+        std::array<GLuint, BufferSlotCount> m_buffers{};
+        std::array<int8_t, CapSlotCount> m_caps{};
+        GLenum m_blendSrc = Unknown;
+        GLenum m_blendDst = Unknown;
+        float m_clearColor[4] = { -1.0f, -1.0f, -1.0f, -1.0f };
+
+        Stats m_current;
+        Stats m_lastFrame;
+
+        StateCache();
+
+        bool Check(bool redundant);
+        static int BufferSlotOf(GLenum target);
+        static int CapSlotOf(GLenum cap);
+        void SetCap(GLenum cap, bool enabled);
+    };
+}
@@ -1,26 +1,126 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <optional>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <SDL3/SDL_opengl.h>
+#include <SDL3/SDL_pixels.h>
 
 #include <Math/Vector.hpp>
 #include <Util/Log.hpp>
+#include <Util/StringInterner.hpp>
+
+namespace Core {
+    class AssetPack;
+    class ThreadPool;
+}
 
 namespace Renderer {
+    class CommandList;
+    class UploadRing;
+
     struct TextureData {
         GLuint id = 0;
         Math::Vector2f size{ 0.0f, 0.0f };
     };
 
+    // Receives the new texture, or nullptr if loading failed
+    using TextureLoadCallback = std::function<void(TextureData*)>;
+
+    struct TextureLoadOptions {
+        bool mipmaps = false;           // full mip chain with trilinear filtering
+        uint32_t thumbnailSize = 0;     // >0: keep only levels at most this large, for list views
+    };
+
+    struct TextureStats {
+        size_t textureCount = 0;
+        size_t residentCount = 0;
+        size_t residentBytes = 0;
+        size_t pinnedBytes = 0;
+        size_t budgetBytes = 0;     // 0: no budget
+        uint64_t evictions = 0;
+        uint64_t reloads = 0;
+        size_t aliasCount = 0;      // names sharing another name's texture
+        size_t dedupSavedBytes = 0; // storage those would have taken on their own
+    };
+
+    // GL thread only, except LoadTextureAsync, GetPendingLoadCount, GetStats and GetSnapshot.
+    //
+    // Every texture is accounted by its GPU footprint. Over budget, textures
+    // loaded from a file that weren't used this frame are evicted oldest first:
+    // the GL name stays valid but its storage shrinks to one transparent pixel,
+    // and the next MarkUsed() on it reloads the file in the background.
+    // Textures without a source file (pixels, AddTexture) are never evicted.
+    //
+    // Decoded files are hashed by content; a file whose pixels match a texture
+    // already loaded with the same options gets that texture's ID. Shared
+    // textures are reference counted and deleted with their last name.
+    //
+    // Names and source paths are kept as interned IDs; the string overloads
+    // look the name up first, the StringId ones skip that.
     class TextureManager {
     private:
-        std::unordered_map<std::string, TextureData> m_nameToTextureData;
-        std::unordered_map<GLuint, std::string> m_textureToName;
+        struct PendingLoad;
+        struct LoadQueue;
+
+        struct Residency {
+            Util::StringId source;  // the owner's normalized file path, or asset name with 'pack'; empty: can't be reloaded
+            const Core::AssetPack* pack = nullptr;
+            TextureLoadOptions options;
+            size_t bytes = 0;       // when resident
+            uint64_t lastUsed = 0;  // frame
+            uint64_t contentHash = 0; // 0: not shared by content
+            int contentWidth = 0;   // decoded size behind contentHash, checked before sharing
+            int contentHeight = 0;
+            uint32_t refCount = 1;  // names pointing at the texture
+            bool pinned = false;
+            bool resident = true;
+            bool reloading = false;
+        };
+
+        std::unordered_map<Util::StringId, TextureData> m_nameToTextureData;
+        std::unordered_map<GLuint, Util::StringId> m_textureToName;
+        std::unordered_map<GLuint, Residency> m_residency;
+        std::unordered_map<uint64_t, GLuint> m_contentToTexture;
+        std::unordered_map<Util::StringId, Util::StringId> m_nameToSource; // per name, aliases may come from other files
+        size_t m_budgetBytes = 0;
+        size_t m_residentBytes = 0;
+        uint64_t m_frame = 1;
+        uint64_t m_evictions = 0;
+        uint64_t m_reloads = 0;
+        std::unique_ptr<UploadRing> m_uploadRing;
+        std::unique_ptr<LoadQueue> m_loads; // after the ring: its workers write into ring slots
         Util::Logger m_logger;
 
-        void DeleteTextureInternal(const std::string& name, GLuint textureID);
+        void DeleteTextureInternal(Util::StringId name, GLuint textureID);
+        void ReleaseName(Util::StringId name, GLuint textureID);
+        void Attach(Util::StringId name, GLuint textureID, const Math::Vector2f& size);
+        void Rebind(Util::StringId name, GLuint textureID, const Math::Vector2f& size);
+        void Rewrite(TextureData& texture, GLuint textureID, const Math::Vector2f& size);
+        UploadRing& GetUploadRing();
+        GLuint CreateTexture(Util::StringId name, int width, int height, int levels = 1);
+        void AllocateStorage(int width, int height, int levels);
+        void UploadFromPack(GLuint textureID, const Core::AssetPack& pack, Util::StringId assetName);
+        TextureData* UploadPixels(Util::StringId name, const void* pixels, SDL_PixelFormat format, int width, int height, int pitch, int levels = 1);
+        TextureData* UploadChain(Util::StringId name, const uint8_t* chain, int width, int height, int levels);
+        void QueueLoad(Util::StringId name, const std::string& filePath, TextureLoadCallback onLoaded, GLuint target,
+            const TextureLoadOptions& options, GLuint splitFrom = 0);
+        void FinishLoad(PendingLoad& job);
+        void FinishSplit(PendingLoad& job);
+        Core::ThreadPool& GetWorkers();
+        GLuint MatchContent(uint64_t contentHash, int width, int height, const TextureLoadOptions& options) const;
+        TextureData* FindByContent(Util::StringId name, uint64_t contentHash, int width, int height,
+            const TextureLoadOptions& options, Util::StringId source);
+        void SetContentHash(GLuint textureID, uint64_t contentHash, int width, int height);
+        void SetSource(GLuint textureID, Util::StringId source, const TextureLoadOptions& options);
+        void SetResidentBytes(GLuint textureID, size_t bytes);
+        void Evict(GLuint textureID, Residency& residency);
+        void EnforceBudget();
+        void PublishStats();
 
     public:
         TextureManager();
@@ -31,14 +131,55 @@ namespace Renderer {
         TextureManager& operator=(TextureManager&&) noexcept;
 
         TextureData* AddTexture(const std::string& name, GLuint textureID, const Math::Vector2f& size);
-        TextureData* AddTextureFromFile(const std::string& name, const std::string& filePath);
+        TextureData* AddTexture(Util::StringId name, GLuint textureID, const Math::Vector2f& size);
+        // Mip chains are generated by GL here; thumbnails are reduced on the CPU
+        TextureData* AddTextureFromFile(const std::string& name, const std::string& filePath,
+            const TextureLoadOptions& options = TextureLoadOptions{});
+        // Cooked textures go to GL as stored, mip levels included. The pack must
+        // outlive the texture, evicted ones are reloaded from it.
+        TextureData* AddTextureFromPack(const std::string& name, const Core::AssetPack& pack, std::string_view assetName);
+        // Uploads RGBA8 pixels (bytes R, G, B, A), top row first. A pitch of 0 means tightly packed rows.
+        TextureData* AddTextureFromPixels(const std::string& name, const void* pixels, int width, int height, int pitch = 0);
+
+        // Decodes on worker threads, which write straight into a pixel buffer;
+        // the GL side finishes in PumpUploads, where 'onLoaded' is called.
+        // Mip chains and thumbnails are built on the workers too.
+        void LoadTextureAsync(const std::string& name, const std::string& filePath, TextureLoadCallback onLoaded = nullptr,
+            const TextureLoadOptions& options = TextureLoadOptions{});
+        // Once per frame on the GL thread, after MarkUsed. Finishes at most
+        // 'maxUploads' textures so big images don't all land in the same frame,
+        // then evicts down to the budget; returns how many uploads finished.
+        size_t PumpUploads(size_t maxUploads = 2);
+        size_t GetPendingLoadCount() const;
+
+        // Reloads every texture loaded from 'filePath' into its existing ID, decoding
+        // in the background like LoadTextureAsync. A texture shared by content with
+        // names from other files isn't overwritten: the names loaded from 'filePath'
+        // move to a texture of their own instead. Returns how many were affected.
+        size_t ReloadFile(const std::string& filePath);
+
+        // Bytes of texture storage to stay under, 0 for no limit
+        void SetBudget(size_t bytes);
+        size_t GetBudget() const;
+        // Pinned textures are never evicted
+        void SetPinned(const std::string& name, bool pinned);
+        // Keeps textures resident this frame and brings evicted ones back
+        void MarkUsed(GLuint textureID);
+        void MarkUsed(const CommandList& commands);
+        // Snapshot published by PumpUploads, safe from any thread
+        TextureStats GetStats() const;
+        // Safe from any thread. Reloads rewrite the TextureData handed out on the
+        // GL thread, other threads copy it through here instead of reading it.
+        TextureData GetSnapshot(const TextureData& texture) const;
 
         void RemoveTextureByName(const std::string& name);
         void RemoveTextureByID(GLuint textureID);
 
         GLuint FindTextureByName(const std::string& name) const;
+        GLuint FindTextureByName(Util::StringId name) const;
         std::optional<std::string> FindNameByTextureID(GLuint textureID) const;
         std::optional<Math::Vector2f> FindSizeByName(const std::string& name) const;
+        std::optional<Math::Vector2f> FindSizeByName(Util::StringId name) const;
         std::optional<Math::Vector2f> FindSizeByID(GLuint textureID) const;
 
         void Clear();
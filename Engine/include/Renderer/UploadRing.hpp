@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <SDL3/SDL_opengl.h>
+
+#include <Util/Log.hpp>
+
+namespace Renderer {
+    // Small ring of pixel unpack buffers that texture uploads are staged through.
+    // With buffer storage every slot stays persistently mapped; otherwise a slot
+    // is mapped when acquired and unmapped right before its upload. A fence per
+    // upload tells when the GPU is done reading a slot. GL thread only; the
+    // pointer of an acquired slot may be written from any thread until Upload().
+    class UploadRing {
+    public:
+        static constexpr int SlotCount = 4;
+        static constexpr size_t DefaultSlotBytes = 4 * 1024 * 1024;
+        static constexpr int NoSlot = -1;
+
+        UploadRing();
+        ~UploadRing();
+        UploadRing(const UploadRing&) = delete;
+        UploadRing& operator=(const UploadRing&) = delete;
+
+        // A writable slot with room for 'bytes'. Without 'wait' returns NoSlot
+        // when every slot is still in flight; with it, blocks on the oldest fence.
+        int Acquire(size_t bytes, bool wait);
+        uint8_t* GetPointer(int slot) const;
+
+        // Copies the slot into 'texture' (already allocated, bound to nothing in
+        // particular) with glTexSubImage2D and fences it. Rows are RGBA8, tightly
+        // packed; with 'levels' > 1 the slot holds that many mip levels back to back.
+        void Upload(int slot, GLuint texture, int width, int height, int levels = 1);
+        // Gives an acquired slot back without uploading
+        void Release(int slot);
+
+        // Frees slots whose fence has signaled
+        void Retire();
+
+        bool IsPersistent() const;
+        size_t GetInFlightCount() const;
+
+    private:
+        enum class SlotState : uint8_t {
+            Free,
+            Writing,
+            InFlight,
+        };
+
+        struct Slot {
+            GLuint buffer = 0;
+            size_t capacity = 0;
+            uint8_t* mapped = nullptr;
+            GLsync fence = nullptr;
+            uint64_t sequence = 0;
+            SlotState state = SlotState::Free;
+        };
+
+        std::array<Slot, SlotCount> m_slots;
+        uint64_t m_sequence = 0;
+        bool m_persistent = false;
+        Util::Logger m_logger;
+
+        void Allocate(Slot& slot, size_t bytes);
+        void Destroy(Slot& slot);
+        bool WaitOldest();
+    };
+}
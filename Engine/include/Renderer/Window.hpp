@@ -2,10 +2,15 @@
 
 #include <SDL3/SDL.h>
 #include <string>
+#include <vector>
 #include <Util/Log.hpp>
 #include <Core/Exceptions.hpp>
 #include <Math/Vector.hpp>
 
+namespace Core {
+    class InputPump;
+}
+
 namespace Renderer {
     class Window {
     private:
@@ -13,6 +18,9 @@ namespace Renderer {
         SDL_Window* m_window;
         SDL_GLContext m_glcontext;
         SDL_Event m_lastEvent;
+        std::vector<SDL_Event> m_events;   // from the last Poll()
+        bool m_quitRequested = false;
+        Core::InputPump* m_inputPump = nullptr;
 
         // Utils
         Util::Logger m_logger;
@@ -31,8 +39,13 @@ namespace Renderer {
         ~Window();
         SDL_Window* GetRawWindow() const;
         SDL_GLContext GetGLContext() const;
+        // Takes this frame's events from SDL, or from the input pump when one is set
         void Poll();
+        // Game thread while the main thread runs the pump; nullptr to poll directly again
+        void SetInputPump(Core::InputPump* pump);
         SDL_Event GetLastEvent() const;
+        // Every event the last Poll() took, in order
+        const std::vector<SDL_Event>& GetEvents() const;
     public:
         // High-level window API
         bool ShouldExit();
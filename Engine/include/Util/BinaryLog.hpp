@@ -0,0 +1,234 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace Util {
+    // On-disk layout of a binary log, written by Util::BinaryLog and turned back
+    // into text by Tools/LogDecoder. Everything is little-endian:
+    //
+    //   Header | Record... | zeroes up to the capacity, or the end of the file
+    //
+    // A call site is described by one Site record the first time it logs. Its
+    // messages then only carry the site ID, a timestamp and the raw arguments.
+    // Writers run concurrently, so a message may land before its site record.
+    namespace BinaryLogFormat {
+        constexpr uint32_t Magic = 0x474F4C47; // "GLOG"
+        constexpr uint32_t Version = 1;
+        constexpr size_t RecordAlignment = 8;
+
+        enum class RecordKind : uint32_t {
+            Site = 1,
+            Message = 2,
+        };
+
+        enum class ArgType : uint8_t {
+            Int = 0,    // int64
+            UInt,       // uint64
+            Double,
+            Bool,       // 1 byte
+            Char,       // 1 byte
+            String,     // uint32 length, then the bytes
+            Pointer,    // uint64
+        };
+
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t capacity;
+            int64_t wallClockNs;    // system_clock at open, since the Unix epoch
+            uint64_t steadyNs;      // steady_clock at the same moment; record timestamps use it
+        };
+
+        struct RecordHeader {
+            uint32_t size;          // whole record with padding, 0 where the log ends
+            RecordKind kind;
+            uint64_t site;
+            uint64_t timestampNs;
+        };
+
+        // Follows a Site record's header, then ArgType[argCount], scope, file and format.
+        // A Message record's header is followed by its arguments, packed.
+        struct SiteInfo {
+            uint8_t level;
+            uint8_t argCount;
+            uint16_t scopeLength;
+            uint16_t fileLength;
+            uint16_t reserved;
+            uint32_t line;
+            uint32_t formatLength;
+        };
+
+        static_assert(sizeof(Header) == 32);
+        static_assert(sizeof(RecordHeader) == 24);
+        static_assert(sizeof(SiteInfo) == 16);
+
+        // Arguments go to the file as one of the types above. Anything that isn't a
+        // number, character, string or pointer is formatted with "{}" up front.
+        template <typename T>
+        auto ToWire(const T& value) {
+            if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char>) {
+                return value;
+            }
+            else if constexpr (std::is_integral_v<T>) {
+                if constexpr (std::is_signed_v<T>) {
+                    return static_cast<int64_t>(value);
+                }
+                else {
+                    return static_cast<uint64_t>(value);
+                }
+            }
+            else if constexpr (std::is_floating_point_v<T>) {
+                return static_cast<double>(value);
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                return std::string_view(value);
+            }
+            else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>) {
+                return static_cast<const void*>(value);
+            }
+            else {
+                return std::format("{}", value);
+            }
+        }
+
+        template <typename Wire>
+        constexpr ArgType TypeOf() {
+            if constexpr (std::is_same_v<Wire, bool>) return ArgType::Bool;
+            else if constexpr (std::is_same_v<Wire, char>) return ArgType::Char;
+            else if constexpr (std::is_same_v<Wire, int64_t>) return ArgType::Int;
+            else if constexpr (std::is_same_v<Wire, uint64_t>) return ArgType::UInt;
+            else if constexpr (std::is_same_v<Wire, double>) return ArgType::Double;
+            else if constexpr (std::is_same_v<Wire, const void*>) return ArgType::Pointer;
+            else return ArgType::String;
+        }
+
+        template <typename Wire>
+        size_t WireSize(const Wire& value) {
+            if constexpr (TypeOf<Wire>() == ArgType::String) {
+                return sizeof(uint32_t) + value.size();
+            }
+            else if constexpr (std::is_same_v<Wire, const void*>) {
+                return sizeof(uint64_t);
+            }
+            else {
+                return sizeof(Wire);
+            }
+        }
+
+        template <typename Wire>
+        void PutWire(uint8_t*& cursor, const Wire& value) {
+            if constexpr (TypeOf<Wire>() == ArgType::String) {
+                uint32_t length = static_cast<uint32_t>(value.size());
+                std::memcpy(cursor, &length, sizeof(length));
+                std::memcpy(cursor + sizeof(length), value.data(), length);
+                cursor += sizeof(length) + length;
+            }
+            else if constexpr (std::is_same_v<Wire, const void*>) {
+                uint64_t address = reinterpret_cast<uintptr_t>(value);
+                std::memcpy(cursor, &address, sizeof(address));
+                cursor += sizeof(address);
+            }
+            else {
+                std::memcpy(cursor, &value, sizeof(value));
+                cursor += sizeof(value);
+            }
+        }
+    }
+
+    // Everything a Site record says about a call site
+    struct LogSite {
+        uint8_t level;
+        std::string_view scope;
+        std::string_view format;
+        std::string_view file;
+        uint32_t line;
+    };
+
+    // Append-only log in a memory-mapped file. Writing a message is a timestamp,
+    // an atomic bump of the write offset and a copy of the raw arguments, with
+    // no formatting and no lock, so it can stay on in shipped builds. When the
+    // file is full further messages are dropped and counted.
+    class BinaryLog {
+    public:
+        static constexpr size_t DefaultCapacity = 64 * 1024 * 1024;
+
+        // Creates or truncates 'path' and maps 'capacity' bytes of it.
+        // Throws Core::Exception on failure.
+        explicit BinaryLog(const std::string& path, size_t capacity = DefaultCapacity);
+        // Trims the file to what was written. Nothing may still be writing.
+        ~BinaryLog();
+        BinaryLog(const BinaryLog&) = delete;
+        BinaryLog& operator=(const BinaryLog&) = delete;
+
+        // Any thread. 'site' identifies the call site, scope and level; 'info'
+        // describes it the first time it is seen.
+        template <typename... Args>
+        void Write(uint64_t site, const LogSite& info, const Args&... args) {
+            uint64_t now = SteadyNs();
+            auto values = std::make_tuple(BinaryLogFormat::ToWire(args)...);
+            if (IsNewSite(site)) {
+                static constexpr std::array<BinaryLogFormat::ArgType, sizeof...(Args)> types{
+                    BinaryLogFormat::TypeOf<decltype(BinaryLogFormat::ToWire(args))>()...
+                };
+                WriteSite(site, info, types.data(), types.size(), now);
+            }
+
+            size_t payload = std::apply([](const auto&... value) {
+                return (size_t{ 0 } + ... + BinaryLogFormat::WireSize(value));
+            }, values);
+            size_t size = sizeof(BinaryLogFormat::RecordHeader) + payload;
+            uint8_t* record = Reserve(size);
+            if (!record) {
+                return;
+            }
+
+            uint8_t* cursor = record + sizeof(BinaryLogFormat::RecordHeader);
+            std::apply([&cursor](const auto&... value) { (BinaryLogFormat::PutWire(cursor, value), ...); }, values);
+            Commit(record, size, BinaryLogFormat::RecordKind::Message, site, now);
+        }
+
+        static uint64_t SteadyNs() {
+            using namespace std::chrono;
+            return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+        }
+
+        const std::string& GetPath() const;
+        uint64_t GetWrittenBytes() const;
+        uint64_t GetDroppedCount() const;
+
+    private:
+        static constexpr size_t SiteSlots = 4096;
+
+        std::string m_path;
+        uint8_t* m_data = nullptr;
+        size_t m_capacity = 0;
+        std::atomic<uint64_t> m_writeOffset{ 0 };
+        std::atomic<uint64_t> m_dropped{ 0 };
+        // Open-addressed set of the sites described so far, 0 is empty
+        std::unique_ptr<std::atomic<uint64_t>[]> m_sites;
+#ifdef _WIN32
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#else
+        int m_fd = -1;
+#endif
+
+        bool IsNewSite(uint64_t site);
+        void WriteSite(uint64_t site, const LogSite& info, const BinaryLogFormat::ArgType* types, size_t argCount, uint64_t timestampNs);
+        // Room for a 'size' byte record plus padding, nullptr when the log is full
+        uint8_t* Reserve(size_t size);
+        // Fills in the record header once the payload is in place
+        void Commit(uint8_t* record, size_t size, BinaryLogFormat::RecordKind kind, uint64_t site, uint64_t timestampNs);
+    };
+}
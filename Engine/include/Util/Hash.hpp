@@ -0,0 +1,115 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace Util {
+    // 64-bit FNV-1a. Cheap and good enough for asset names; not for anything adversarial.
+    constexpr uint64_t Fnv1aOffset = 0xCBF29CE484222325ull;
+    constexpr uint64_t Fnv1aPrime = 0x100000001B3ull;
+
+    inline uint64_t Fnv1a(const void* data, size_t size, uint64_t hash = Fnv1aOffset) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= Fnv1aPrime;
+        }
+        return hash;
+    }
+
+    constexpr uint64_t Fnv1a(std::string_view text, uint64_t hash = Fnv1aOffset) {
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= Fnv1aPrime;
+        }
+        return hash;
+    }
+
+    static_assert(Fnv1a("") == Fnv1aOffset);
+    static_assert(Fnv1a("a") == 0xAF63DC4C8601EC8Cull);
+
+    // XXH64. Several GB/s on bulk data, for content hashing; output matches the reference implementation.
+    namespace Detail {
+        constexpr uint64_t XxPrime1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t XxPrime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t XxPrime3 = 0x165667B19E3779F9ull;
+        constexpr uint64_t XxPrime4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64_t XxPrime5 = 0x27D4EB2F165667C5ull;
+
+        inline uint64_t Read64(const unsigned char* p) {
+            uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline uint32_t Read32(const unsigned char* p) {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline uint64_t XxRound(uint64_t acc, uint64_t input) {
+            acc += input * XxPrime2;
+            acc = std::rotl(acc, 31);
+            return acc * XxPrime1;
+        }
+
+        inline uint64_t XxMerge(uint64_t acc, uint64_t value) {
+            acc ^= XxRound(0, value);
+            return acc * XxPrime1 + XxPrime4;
+        }
+    }
+
+    inline uint64_t Hash64(const void* data, size_t size, uint64_t seed = 0) {
+        using namespace Detail;
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        const unsigned char* end = p + size;
+        uint64_t hash;
+
+        if (size >= 32) {
+            uint64_t v1 = seed + XxPrime1 + XxPrime2;
+            uint64_t v2 = seed + XxPrime2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - XxPrime1;
+            for (; end - p >= 32; p += 32) {
+                v1 = XxRound(v1, Read64(p));
+                v2 = XxRound(v2, Read64(p + 8));
+                v3 = XxRound(v3, Read64(p + 16));
+                v4 = XxRound(v4, Read64(p + 24));
+            }
+            hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+            hash = XxMerge(hash, v1);
+            hash = XxMerge(hash, v2);
+            hash = XxMerge(hash, v3);
+            hash = XxMerge(hash, v4);
+        }
+        else {
+            hash = seed + XxPrime5;
+        }
+
+        hash += static_cast<uint64_t>(size);
+        for (; end - p >= 8; p += 8) {
+            hash ^= XxRound(0, Read64(p));
+            hash = std::rotl(hash, 27) * XxPrime1 + XxPrime4;
+        }
+        if (end - p >= 4) {
+            hash ^= static_cast<uint64_t>(Read32(p)) * XxPrime1;
+            hash = std::rotl(hash, 23) * XxPrime2 + XxPrime3;
+            p += 4;
+        }
+        for (; p < end; ++p) {
+            hash ^= *p * XxPrime5;
+            hash = std::rotl(hash, 11) * XxPrime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= XxPrime2;
+        hash ^= hash >> 29;
+        hash *= XxPrime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+}
@@ -4,8 +4,17 @@
 #include <string_view>
 #include <mutex>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <ctime>
+#include <cstring>
+#include <atomic>
+#include <source_location>
+#include <concepts>
+#include <array>
+#include <unordered_map>
+#include <algorithm>
+
+#include <Util/BinaryLog.hpp>
+#include <Util/Hash.hpp>
 
 namespace Util {
     class Logger {
@@ -17,60 +26,244 @@ namespace Util {
             Error,
         };
 
-        constexpr Logger(std::string_view scope) : scope(scope) {}
+        // A format string literal and the line it was written on, captured at
+        // compile time. Its ID names the call site in binary logs.
+        struct Format {
+            std::string_view text;
+            std::source_location location;
+            uint64_t id;
+
+            template<typename String> requires std::convertible_to<const String&, std::string_view>
+            consteval Format(const String& text, std::source_location location = std::source_location::current())
+                : text(text), location(location),
+                id(Fnv1a(this->text, Fnv1a(location.file_name()) ^ location.line())) {
+            }
+        };
+
+        constexpr Logger(std::string_view scope) : scope(scope), scopeHash(Fnv1a(scope)) {}
 
         static void SetLogLevel(Level level) {
-            currentLevel = level;
+            currentLevel.store(level, std::memory_order_relaxed);
         }
 
         static Level GetLogLevel() {
-            return currentLevel;
+            return currentLevel.load(std::memory_order_relaxed);
         }
 
-        template<typename... Args>
-        void Log(Level level, std::string_view fmt_str, Args&&... args) const {
-            if (level < currentLevel) return;
+        // Overrides the global level for every logger named 'scope', any thread.
+        // False when too many scopes are overridden already.
+        static bool SetScopeLevel(std::string_view scope, Level level) {
+            return storeScopeLevel(Fnv1a(scope), static_cast<int>(level));
+        }
+
+        static void ClearScopeLevel(std::string_view scope) {
+            storeScopeLevel(Fnv1a(scope), InheritLevel);
+        }
+
+        static constexpr bool ParseLevel(std::string_view name, Level& level) {
+            for (Level candidate : { Level::Debug, Level::Info, Level::Warn, Level::Error }) {
+                std::string_view prefix = levelPrefix(candidate);
+                if (name.size() == prefix.size() && std::equal(name.begin(), name.end(), prefix.begin(),
+                    [](char a, char b) { return (a >= 'a' && a <= 'z' ? a - 'a' + 'A' : a) == b; })) {
+                    level = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
 
+        // Text output from each call site is a token bucket: 'burst' lines at once,
+        // refilled at 'perSecond'. What doesn't fit is counted and reported with
+        // the site's next line. 0 turns limiting off.
+        static void SetRateLimit(double perSecond, double burst) {
             std::lock_guard lock(outputMutex);
+            ratePerSecond = perSecond;
+            rateBurst = burst;
+        }
+
+        // Reports the sites that are still holding back messages
+        static void FlushSuppressed() {
+            std::lock_guard lock(outputMutex);
+            for (auto& [site, bucket] : buckets) {
+                reportSuppressed(bucket);
+            }
+        }
 
-            std::string prefix = std::string(levelPrefix(level));
-            std::string message = std::vformat(std::string(fmt_str), std::make_format_args(args...));
-            std::string timeStr = getTimestamp();
-            std::string color = levelColor(level);
-            std::string resetColor = "\033[0m";
+        Level GetEffectiveLevel() const {
+            size_t count = scopeLevelCount.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                if (scopeLevels[i].scopeHash.load(std::memory_order_relaxed) == scopeHash) {
+                    int level = scopeLevels[i].level.load(std::memory_order_relaxed);
+                    if (level != InheritLevel) {
+                        return static_cast<Level>(level);
+                    }
+                    break;
+                }
+            }
+            return currentLevel.load(std::memory_order_relaxed);
+        }
 
-            std::cout << color
-                << "[" << timeStr << "] "
-                << "[" << prefix << "] "
-                << "[" << scope << "] "
-                << message
-                << resetColor << '\n';
+        // Sends every logger's output to 'log' as raw records instead of text,
+        // nullptr goes back to stdout. Set it before the threads that log start
+        // and clear it before destroying the log.
+        static void SetBinaryOutput(BinaryLog* log) {
+            binaryOutput.store(log, std::memory_order_release);
+        }
+
+        static BinaryLog* GetBinaryOutput() {
+            return binaryOutput.load(std::memory_order_acquire);
+        }
+
+        static constexpr std::string_view GetLevelName(Level level) {
+            return levelPrefix(level);
         }
 
         template<typename... Args>
-        void Info(std::string_view fmt_str, Args&&... args) const {
-            Log(Level::Info, fmt_str, std::forward<Args>(args)...);
+        void Log(Level level, Format fmt, Args&&... args) const {
+            if (level < GetEffectiveLevel()) return;
+
+            if (BinaryLog* binary = binaryOutput.load(std::memory_order_acquire)) {
+                // Same line in another scope or at another level is another site
+                uint64_t site = (fmt.id ^ scopeHash) * Fnv1aPrime + static_cast<uint64_t>(level);
+                binary->Write(site | 1, LogSite{ static_cast<uint8_t>(level), scope, fmt.text,
+                    fmt.location.file_name(), fmt.location.line() }, args...);
+                return;
+            }
+
+            std::lock_guard lock(outputMutex);
+            if (ratePerSecond > 0.0) {
+                Bucket& bucket = buckets[fmt.id ^ scopeHash];
+                if (!takeToken(bucket, level, scope, fmt)) {
+                    return;
+                }
+                reportSuppressed(bucket);
+            }
+
+            std::string message = std::vformat(fmt.text, std::make_format_args(args...));
+            writeLine(level, scope, message);
         }
 
         template<typename... Args>
-        void Warn(std::string_view fmt_str, Args&&... args) const {
-            Log(Level::Warn, fmt_str, std::forward<Args>(args)...);
+        void Info(Format fmt, Args&&... args) const {
+            Log(Level::Info, fmt, std::forward<Args>(args)...);
         }
 
         template<typename... Args>
-        void Error(std::string_view fmt_str, Args&&... args) const {
-            Log(Level::Error, fmt_str, std::forward<Args>(args)...);
+        void Warn(Format fmt, Args&&... args) const {
+            Log(Level::Warn, fmt, std::forward<Args>(args)...);
         }
 
         template<typename... Args>
-        void Debug(std::string_view fmt_str, Args&&... args) const {
-            Log(Level::Debug, fmt_str, std::forward<Args>(args)...);
+        void Error(Format fmt, Args&&... args) const {
+            Log(Level::Error, fmt, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        void Debug(Format fmt, Args&&... args) const {
+            Log(Level::Debug, fmt, std::forward<Args>(args)...);
         }
 
     private:
         std::string_view scope;
+        uint64_t scopeHash;
         inline static std::mutex outputMutex;
-        inline static Level currentLevel = Level::Debug;
+        inline static std::atomic<BinaryLog*> binaryOutput{ nullptr };
+        inline static std::atomic<Level> currentLevel{ Level::Debug };
+
+        static constexpr int InheritLevel = -1;
+        static constexpr size_t MaxScopeLevels = 32;
+
+        struct ScopeLevel {
+            std::atomic<uint64_t> scopeHash;
+            std::atomic<int> level;
+        };
+
+        // Append-only, so readers can walk it without the lock. Slots past the
+        // count are zeroed static storage until storeScopeLevel fills them.
+        inline static std::array<ScopeLevel, MaxScopeLevels> scopeLevels;
+        inline static std::atomic<size_t> scopeLevelCount{ 0 };
+        inline static std::mutex scopeLevelMutex;
+
+        struct Bucket {
+            double tokens = -1.0;   // below zero until first used
+            uint64_t lastNs = 0;
+            uint64_t suppressed = 0;
+            Level level = Level::Info;
+            std::string_view scope;
+            std::string_view file;
+            uint32_t line = 0;
+        };
+
+        // Guarded by outputMutex
+        inline static std::unordered_map<uint64_t, Bucket> buckets;
+        inline static double ratePerSecond = 10.0;
+        inline static double rateBurst = 20.0;
+
+        static bool storeScopeLevel(uint64_t hash, int level) {
+            std::lock_guard lock(scopeLevelMutex);
+            size_t count = scopeLevelCount.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < count; ++i) {
+                if (scopeLevels[i].scopeHash.load(std::memory_order_relaxed) == hash) {
+                    scopeLevels[i].level.store(level, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            if (level == InheritLevel) {
+                return true;
+            }
+            if (count == MaxScopeLevels) {
+                return false;
+            }
+            scopeLevels[count].scopeHash.store(hash, std::memory_order_relaxed);
+            scopeLevels[count].level.store(level, std::memory_order_relaxed);
+            scopeLevelCount.store(count + 1, std::memory_order_release);
+            return true;
+        }
+
+        static bool takeToken(Bucket& bucket, Level level, std::string_view scope, const Format& fmt) {
+            uint64_t now = BinaryLog::SteadyNs();
+            if (bucket.tokens < 0.0) {
+                bucket.tokens = rateBurst;
+                bucket.level = level;
+                bucket.scope = scope;
+                bucket.file = fmt.location.file_name();
+                bucket.line = fmt.location.line();
+            }
+            else {
+                bucket.tokens = std::min(rateBurst, bucket.tokens + (now - bucket.lastNs) * 1e-9 * ratePerSecond);
+            }
+            bucket.lastNs = now;
+
+            if (bucket.tokens < 1.0) {
+                ++bucket.suppressed;
+                return false;
+            }
+            bucket.tokens -= 1.0;
+            return true;
+        }
+
+        static void reportSuppressed(Bucket& bucket) {
+            if (bucket.suppressed == 0) {
+                return;
+            }
+            std::string_view file = bucket.file.substr(bucket.file.find_last_of("/\\") + 1);
+            writeLine(bucket.level, bucket.scope,
+                std::format("{} messages suppressed from {}:{}", bucket.suppressed, file, bucket.line));
+            bucket.suppressed = 0;
+        }
+
+        // Caller holds outputMutex
+        static void writeLine(Level level, std::string_view scope, std::string_view message) {
+            char timeStr[TimestampLength];
+            formatTimestamp(timeStr);
+
+            std::cout << levelColor(level)
+                << "[" << std::string_view(timeStr, TimestampLength) << "] "
+                << "[" << levelPrefix(level) << "] "
+                << "[" << scope << "] "
+                << message
+                << "\033[0m" << '\n';
+        }
 
         static constexpr std::string_view levelPrefix(Level level) {
             switch (level) {
@@ -92,17 +285,36 @@ namespace Util {
             }
         }
 
-        static std::string getTimestamp() {
+        // "HH:MM:SS.mmm", not terminated
+        static constexpr size_t TimestampLength = 12;
+
+        static void formatTimestamp(char (&out)[TimestampLength]) {
             using namespace std::chrono;
 
-            auto now = system_clock::now();
-            auto itt = system_clock::to_time_t(now);
-            auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
+            // The clock part only changes once a second, and the local time
+            // conversion behind it is the expensive bit
+            thread_local time_t cachedSecond = -1;
+            thread_local char cachedClock[9];
+
+            int64_t ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+            time_t second = static_cast<time_t>(ms / 1000);
+            if (second != cachedSecond) {
+                std::tm local{};
+#ifdef _WIN32
+                localtime_s(&local, &second);
+#else
+                localtime_r(&second, &local);
+#endif
+                std::strftime(cachedClock, sizeof(cachedClock), "%H:%M:%S", &local);
+                cachedSecond = second;
+            }
 
-            std::ostringstream ss;
-            ss << std::put_time(std::localtime(&itt), "%H:%M:%S")
-                << '.' << std::setfill('0') << std::setw(3) << ms.count();
-            return ss.str();
+            int millis = static_cast<int>(ms % 1000);
+            std::memcpy(out, cachedClock, 8);
+            out[8] = '.';
+            out[9] = static_cast<char>('0' + millis / 100);
+            out[10] = static_cast<char>('0' + millis / 10 % 10);
+            out[11] = static_cast<char>('0' + millis % 10);
         }
     };
 }
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+namespace Util {
+    // A string interned in the global StringInterner. Compares and hashes as
+    // its 32-bit ID; the text is only looked at to print it. IDs are stable for
+    // the life of the process and 0 is the empty string.
+    class StringId {
+    public:
+        constexpr StringId() = default;
+
+        constexpr uint32_t GetValue() const { return m_value; }
+        constexpr bool IsEmpty() const { return m_value == 0; }
+
+        // Reverse lookup. Stays valid for the life of the process, NUL-terminated.
+        std::string_view View() const;
+        const char* CStr() const;
+        // FNV-1a of the text (Util::Fnv1a), computed once when it was interned
+        uint64_t GetHash() const;
+
+        friend constexpr bool operator==(StringId, StringId) = default;
+        friend constexpr auto operator<=>(StringId, StringId) = default;
+
+    private:
+        friend class StringInterner;
+        explicit constexpr StringId(uint32_t value) : m_value(value) {}
+
+        uint32_t m_value = 0;
+    };
+
+    // Process-wide table of names (textures, assets, anything looked up by
+    // name), each stored once in an arena. Interning and finding take a lock;
+    // going from an ID back to its text doesn't.
+    class StringInterner {
+    public:
+        static StringInterner& Get();
+
+        StringInterner(const StringInterner&) = delete;
+        StringInterner& operator=(const StringInterner&) = delete;
+
+        // Any thread
+        StringId Intern(std::string_view text);
+        // Like Intern but never adds, for lookups of names that may not exist
+        std::optional<StringId> Find(std::string_view text) const;
+
+        std::string_view View(StringId id) const;
+        uint64_t GetHash(StringId id) const;
+
+        size_t GetCount() const;
+        size_t GetArenaBytes() const;
+
+    private:
+        struct Entry {
+            const char* text;
+            uint32_t length;
+            uint64_t hash;
+        };
+
+        static constexpr size_t ChunkBits = 12;
+        static constexpr size_t ChunkSize = size_t{ 1 } << ChunkBits;
+        static constexpr size_t MaxChunks = 1024;   // 4M strings
+        static constexpr size_t ArenaBlockSize = 64 * 1024;
+
+        // Entries never move once written, so View() reads them without the lock.
+        // An ID only reaches another thread through something that synchronizes.
+        std::array<std::unique_ptr<Entry[]>, MaxChunks> m_chunks;
+        uint32_t m_count = 0;
+
+        // Open addressing on the hash, slots hold IDs, 0 is empty
+        std::vector<uint32_t> m_slots;
+        std::vector<std::unique_ptr<char[]>> m_arena;
+        size_t m_arenaUsed = ArenaBlockSize;    // in the last block
+        size_t m_arenaBytes = 0;
+        mutable std::shared_mutex m_mutex;
+
+        StringInterner();
+
+        const Entry& GetEntry(uint32_t id) const;
+        // Slot holding 'text', or the empty slot where it would go
+        size_t Probe(std::string_view text, uint64_t hash) const;
+        const char* Store(std::string_view text);
+        void Grow();
+    };
+
+    inline StringId Intern(std::string_view text) {
+        return StringInterner::Get().Intern(text);
+    }
+}
+
+template<>
+struct std::hash<Util::StringId> {
+    size_t operator()(Util::StringId id) const noexcept {
+        return id.GetValue();
+    }
+};
+
+// Logs and formats as its text
+template<>
+struct std::formatter<Util::StringId> : std::formatter<std::string_view> {
+    auto format(Util::StringId id, std::format_context& context) const {
+        return std::formatter<std::string_view>::format(id.View(), context);
+    }
+};
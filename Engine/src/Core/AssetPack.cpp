@@ -0,0 +1,89 @@
+#include <Core/AssetPack.hpp>
+#include <Core/Exceptions.hpp>
+#include <Util/Hash.hpp>
+#include <cstring>
+
+using namespace Core;
+
+AssetPack::AssetPack(const std::string& path)
+    : m_file(path), m_logger("AssetPack") {
+    const uint8_t* data = m_file.GetData();
+    size_t size = m_file.GetSize();
+
+    PackFormat::Header header{};
+    if (size < sizeof(header)) {
+        throw Exception("AssetPack: '" + path + "' is too small to be a pack");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != PackFormat::Magic) {
+        throw Exception("AssetPack: '" + path + "' is not an asset pack");
+    }
+    if (header.version != PackFormat::Version) {
+        throw Exception("AssetPack: '" + path + "' is version " + std::to_string(header.version) +
+            ", expected " + std::to_string(PackFormat::Version));
+    }
+
+    size_t indexBytes = static_cast<size_t>(header.entryCount) * sizeof(Entry);
+    if (header.indexOffset % alignof(Entry) != 0 || header.indexOffset > size || size - header.indexOffset < indexBytes) {
+        throw Exception("AssetPack: '" + path + "' has a truncated index");
+    }
+
+    m_entries = reinterpret_cast<const Entry*>(data + header.indexOffset);
+    m_entryCount = header.entryCount;
+
+    for (uint32_t i = 0; i < m_entryCount; ++i) {
+        const Entry& entry = m_entries[i];
+        if (entry.offset > header.indexOffset || header.indexOffset - entry.offset < entry.size) {
+            throw Exception("AssetPack: '" + path + "' has an entry outside its data");
+        }
+        if (entry.type == PackFormat::AssetType::Texture) {
+            size_t expected = 0;
+            for (uint32_t level = 0; level < entry.mipCount && level < 32; ++level) {
+                expected += PackFormat::MipBytes(entry.width, entry.height, level);
+            }
+            if (entry.width == 0 || entry.height == 0 || entry.mipCount == 0 || entry.mipCount > 32 || entry.size < expected) {
+                throw Exception("AssetPack: '" + path + "' has a malformed texture entry");
+            }
+        }
+        if (i > 0 && m_entries[i - 1].hash >= entry.hash) {
+            throw Exception("AssetPack: '" + path + "' has an unsorted index");
+        }
+    }
+
+    m_logger.Info("Mapped '{}': {} assets, {} KiB", path, m_entryCount, size / 1024);
+}
+
+const AssetPack::Entry* AssetPack::Find(std::string_view name) const {
+    return Find(Util::Fnv1a(name));
+}
+
+const AssetPack::Entry* AssetPack::Find(uint64_t hash) const {
+    const Entry* end = m_entries + m_entryCount;
+    const Entry* it = std::lower_bound(m_entries, end, hash,
+        [](const Entry& entry, uint64_t value) { return entry.hash < value; });
+    return it != end && it->hash == hash ? it : nullptr;
+}
+
+const uint8_t* AssetPack::GetData(const Entry& entry) const {
+    return m_file.GetData() + entry.offset;
+}
+
+const uint8_t* AssetPack::GetMipData(const Entry& entry, uint32_t level) const {
+    if (entry.type != PackFormat::AssetType::Texture || level >= entry.mipCount) {
+        throw Exception("AssetPack::GetMipData: no mip level " + std::to_string(level));
+    }
+
+    size_t offset = 0;
+    for (uint32_t i = 0; i < level; ++i) {
+        offset += PackFormat::MipBytes(entry.width, entry.height, i);
+    }
+    return GetData(entry) + offset;
+}
+
+size_t AssetPack::GetEntryCount() const {
+    return m_entryCount;
+}
+
+const std::string& AssetPack::GetPath() const {
+    return m_file.GetPath();
+}
@@ -0,0 +1,211 @@
+#include <Core/FileWatcher.hpp>
+#include <filesystem>
+#include <system_error>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+using namespace Core;
+
+namespace fs = std::filesystem;
+
+namespace {
+    // "assets/./" and "assets" are the same root, so reported paths don't depend on spelling
+    std::string Normalize(const std::string& path) {
+        fs::path normal = fs::path(path).lexically_normal();
+        if (!normal.has_filename() && normal.has_parent_path()) {
+            normal = normal.parent_path();
+        }
+        return normal.generic_string();
+    }
+}
+
+FileWatcher::FileWatcher()
+    : m_logger("FileWatcher") {
+}
+
+bool FileWatcher::IsSupported() {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t FileWatcher::Poll() {
+    std::vector<std::pair<std::string, Callback>> ready;
+    {
+        std::lock_guard lock(m_mutex);
+        Clock::time_point now = Clock::now();
+        for (auto it = m_changes.begin(); it != m_changes.end();) {
+            if (now - it->second.lastEvent >= SettleTime) {
+                ready.emplace_back(it->first, m_roots[it->second.root].callback);
+                it = m_changes.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    // Outside the lock, callbacks may take a while
+    for (const auto& [path, callback] : ready) {
+        m_logger.Debug("Changed: {}", path);
+        callback(path);
+    }
+    return ready.size();
+}
+
+#ifdef __linux__
+/* ============================================================== */
+/* inotify                                                        */
+/* ============================================================== */
+namespace {
+    constexpr uint32_t DirectoryMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+}
+
+FileWatcher::~FileWatcher() {
+    if (m_thread.joinable()) {
+        uint64_t one = 1;
+        ssize_t written = write(m_wake, &one, sizeof(one));
+        (void)written;
+        m_thread.join();
+    }
+    if (m_inotify >= 0) {
+        close(m_inotify);
+    }
+    if (m_wake >= 0) {
+        close(m_wake);
+    }
+}
+
+bool FileWatcher::Watch(const std::string& directory, Callback callback) {
+    std::error_code error;
+    if (!fs::is_directory(directory, error)) {
+        m_logger.Warn("Not watching '{}': not a directory", directory);
+        return false;
+    }
+
+    std::lock_guard lock(m_mutex);
+    if (m_inotify < 0) {
+        m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        m_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_inotify < 0 || m_wake < 0) {
+            m_logger.Error("inotify unavailable: {}", std::strerror(errno));
+            return false;
+        }
+    }
+
+    m_roots.push_back(Root{ Normalize(directory), std::move(callback) });
+    AddTree(m_roots.back().directory, m_roots.size() - 1);
+    m_logger.Info("Watching '{}'", m_roots.back().directory);
+
+    if (!m_thread.joinable()) {
+        m_thread = std::thread(&FileWatcher::ThreadMain, this);
+    }
+    return true;
+}
+
+// Caller holds m_mutex
+void FileWatcher::AddTree(const std::string& directory, size_t root) {
+    auto add = [&](const std::string& path) {
+        int descriptor = inotify_add_watch(m_inotify, path.c_str(), DirectoryMask);
+        if (descriptor < 0) {
+            m_logger.Warn("Can't watch '{}': {}", path, std::strerror(errno));
+            return;
+        }
+        m_watches[descriptor] = { path, root };
+    };
+
+    add(directory);
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(directory, error), end; it != end; it.increment(error)) {
+        if (it->is_directory(error)) {
+            add(it->path().generic_string());
+        }
+    }
+}
+
+void FileWatcher::ThreadMain() {
+    // Big enough for a burst of events, aligned for inotify_event
+    alignas(inotify_event) char buffer[16 * 1024];
+    pollfd fds[2] = {
+        { m_inotify, POLLIN, 0 },
+        { m_wake, POLLIN, 0 },
+    };
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            m_logger.Error("poll failed: {}", std::strerror(errno));
+            return;
+        }
+        if (fds[1].revents & POLLIN) {
+            return;
+        }
+
+        ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+        if (length <= 0) {
+            continue;
+        }
+
+        std::lock_guard lock(m_mutex);
+        Clock::time_point now = Clock::now();
+        for (char* at = buffer; at < buffer + length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(at);
+            at += sizeof(inotify_event) + event->len;
+
+            auto watch = m_watches.find(event->wd);
+            if (watch == m_watches.end() || event->len == 0) {
+                continue;
+            }
+
+            std::string path = watch->second.first + "/" + event->name;
+            size_t root = watch->second.second;
+            if (event->mask & IN_ISDIR) {
+                // New directories get watched, and whatever is already inside counts as changed
+                AddTree(path, root);
+                std::error_code error;
+                for (fs::recursive_directory_iterator it(path, error), end; it != end; it.increment(error)) {
+                    if (it->is_regular_file(error)) {
+                        m_changes[it->path().generic_string()] = Change{ root, now };
+                    }
+                }
+                continue;
+            }
+            // A create alone is usually followed by writes; wait for the close
+            if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+                m_changes[path] = Change{ root, now };
+            }
+        }
+    }
+}
+#else
+/* ============================================================== */
+/* Unsupported platforms                                          */
+/* ============================================================== */
+FileWatcher::~FileWatcher() = default;
+
+bool FileWatcher::Watch(const std::string& directory, Callback) {
+    static bool warned = false;
+    if (!warned) {
+        m_logger.Warn("File watching isn't supported on this platform, '{}' won't hot reload", directory);
+        warned = true;
+    }
+    return false;
+}
+
+void FileWatcher::AddTree(const std::string&, size_t) {
+}
+
+void FileWatcher::ThreadMain() {
+}
+#endif
@@ -0,0 +1,154 @@
+#include <Core/FramePacer.hpp>
+#include <Math/Simd.hpp>
+#include <algorithm>
+#include <thread>
+
+using namespace Core;
+
+namespace {
+    // Spun even when sleeps have been waking on time, wakeups still jitter
+    constexpr uint64_t MinSpinNs = 100'000;
+    constexpr uint64_t InitialSleepSlackNs = 1'000'000;
+    // Past this a rare bad wakeup costs less than spinning through every frame after it
+    constexpr uint64_t MaxSleepSlackNs = 4'000'000;
+
+    const char* ModeName(FramePacer::Mode mode) {
+        switch (mode) {
+        case FramePacer::Mode::Unlimited: return "unlimited";
+        case FramePacer::Mode::Limit: return "limit";
+        case FramePacer::Mode::JustInTime: return "just in time";
+        }
+        return "unknown";
+    }
+
+    void CpuRelax() {
+#ifdef MATH_SIMD_SSE2
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+}
+
+FramePacer::FramePacer(double targetHz, Mode mode)
+    : m_mode(mode), m_sleepSlackNs(InitialSleepSlackNs), m_logger("FramePacer") {
+    SetTargetRate(targetHz);
+}
+
+void FramePacer::SetTargetRate(double hz) {
+    m_periodNs = hz > 0.0 ? static_cast<uint64_t>(1e9 / hz) : 0;
+    m_deadlineNs = 0;
+    m_stats.targetHz = hz > 0.0 ? hz : 0.0;
+    m_logger.Info("Pacing to {:.2f} Hz ({})", m_stats.targetHz, ModeName(m_mode));
+}
+
+double FramePacer::GetTargetRate() const {
+    return m_stats.targetHz;
+}
+
+void FramePacer::SetMode(Mode mode) {
+    if (mode == m_mode) {
+        return;
+    }
+    m_mode = mode;
+    m_deadlineNs = 0;
+    m_logger.Info("Pacing to {:.2f} Hz ({})", m_stats.targetHz, ModeName(m_mode));
+}
+
+FramePacer::Mode FramePacer::GetMode() const {
+    return m_mode;
+}
+
+void FramePacer::BeginFrame() {
+    uint64_t now = SDL_GetTicksNS();
+    if (m_periodNs == 0 || m_mode == Mode::Unlimited) {
+        m_deadlineNs = 0;
+        m_stats.waitMs = 0.0f;
+        m_stats.spinMs = 0.0f;
+    }
+    else {
+        if (m_deadlineNs == 0) {
+            m_deadlineNs = now + m_periodNs;
+        }
+        if (m_mode == Mode::JustInTime) {
+            // Start late enough that the frame is done just before it's due
+            uint64_t budget = m_workEstimateNs + SafetyMarginNs;
+            WaitUntil(m_deadlineNs > budget ? m_deadlineNs - budget : 0);
+            now = SDL_GetTicksNS();
+        }
+    }
+
+    if (m_frameStartNs != 0) {
+        m_stats.frameMs = static_cast<float>(now - m_frameStartNs) / 1e6f;
+    }
+    m_frameStartNs = now;
+}
+
+void FramePacer::EndFrame() {
+    uint64_t now = SDL_GetTicksNS();
+    uint64_t work = now - m_frameStartNs;
+    // Rises at once, decays slowly: one quick frame shouldn't make the next one late
+    m_workEstimateNs = work > m_workEstimateNs ? work : m_workEstimateNs - (m_workEstimateNs - work) / 16;
+    m_stats.workMs = static_cast<float>(work) / 1e6f;
+    m_stats.estimateMs = static_cast<float>(m_workEstimateNs) / 1e6f;
+    if (m_deadlineNs == 0) {
+        return;
+    }
+
+    if (now > m_deadlineNs) {
+        ++m_stats.late;
+    }
+    if (m_mode == Mode::Limit) {
+        WaitUntil(m_deadlineNs);
+        now = SDL_GetTicksNS();
+    }
+
+    m_deadlineNs += m_periodNs;
+    if (m_deadlineNs <= now) {
+        // Missed by a whole period, start over rather than rush to catch up
+        m_deadlineNs = now + m_periodNs;
+    }
+}
+
+const FramePacer::Stats& FramePacer::GetStats() const {
+    return m_stats;
+}
+
+double FramePacer::GetRefreshRate(SDL_Window* window) {
+    SDL_DisplayID display = window ? SDL_GetDisplayForWindow(window) : SDL_GetPrimaryDisplay();
+    const SDL_DisplayMode* mode = display ? SDL_GetCurrentDisplayMode(display) : nullptr;
+    return mode && mode->refresh_rate > 0.0f ? mode->refresh_rate : 60.0;
+}
+
+void FramePacer::WaitUntil(uint64_t deadlineNs) {
+    uint64_t start = SDL_GetTicksNS();
+    uint64_t now = start;
+    m_stats.waitMs = 0.0f;
+    m_stats.spinMs = 0.0f;
+    if (deadlineNs <= now) {
+        return;
+    }
+
+    // Sleep through what the scheduler can be trusted with, spin the rest
+    uint64_t spinWindow = m_sleepSlackNs + MinSpinNs;
+    if (deadlineNs - now > spinWindow) {
+        uint64_t request = deadlineNs - now - spinWindow;
+        SDL_DelayNS(request);
+        uint64_t woke = SDL_GetTicksNS();
+        uint64_t overshoot = woke - now > request ? woke - now - request : 0;
+        // Jumps up at once, creeps back down
+        m_sleepSlackNs = overshoot > m_sleepSlackNs ? overshoot : m_sleepSlackNs - (m_sleepSlackNs - overshoot) / 8;
+        m_sleepSlackNs = std::min(m_sleepSlackNs, MaxSleepSlackNs);
+        now = woke;
+    }
+
+    uint64_t spinStart = now;
+    while (now < deadlineNs) {
+        CpuRelax();
+        now = SDL_GetTicksNS();
+    }
+
+    m_stats.waitMs = static_cast<float>(now - start) / 1e6f;
+    m_stats.spinMs = static_cast<float>(now - spinStart) / 1e6f;
+    m_stats.sleepSlackMs = static_cast<float>(m_sleepSlackNs) / 1e6f;
+}
@@ -1,10 +1,266 @@
 #include <Core/Input.hpp>
+#include <Util/Log.hpp>
 #include <SDL3/SDL.h>
-#include <Game.hpp>
-#include <unordered_set>
+#include <algorithm>
+#include <cmath>
 
 namespace Core {
     namespace Input {
+        namespace {
+            constexpr uint8_t NoAction = 0xFF;
+            constexpr int MaxJoystickButtons = 64;
+            // Longer gaps between reports are the player resting, not the polling rate
+            constexpr uint64_t IdleGapNs = 50'000'000;
+            constexpr size_t IntervalHistory = 256;
+            constexpr size_t MinIntervals = 16;
+
+            struct Bindings {
+                std::array<uint8_t, SDL_SCANCODE_COUNT> keys;
+                std::array<uint8_t, SDL_GAMEPAD_BUTTON_COUNT> gamepadButtons;
+                std::array<uint8_t, MaxJoystickButtons> joystickButtons;
+
+                Bindings() { Clear(); }
+
+                void Clear() {
+                    keys.fill(NoAction);
+                    gamepadButtons.fill(NoAction);
+                    joystickButtons.fill(NoAction);
+                }
+
+                uint8_t* Find(BindingSource source, int code) {
+                    switch (source) {
+                    case BindingSource::Key:
+                        return code >= 0 && code < SDL_SCANCODE_COUNT ? &keys[code] : nullptr;
+                    case BindingSource::GamepadButton:
+                        return code >= 0 && code < SDL_GAMEPAD_BUTTON_COUNT ? &gamepadButtons[code] : nullptr;
+                    case BindingSource::JoystickButton:
+                        return code >= 0 && code < MaxJoystickButtons ? &joystickButtons[code] : nullptr;
+                    }
+                    return nullptr;
+                }
+            };
+
+            struct Device {
+                SDL_JoystickID id = 0;
+                SDL_Gamepad* gamepad = nullptr;     // or
+                SDL_Joystick* joystick = nullptr;
+                std::string name;
+                bool isVirtual = false;
+                uint64_t held = 0;                  // buttons, in the numbering of whichever is open
+                uint64_t lastReportNs = 0;
+                uint64_t reports = 0;
+                std::array<uint32_t, IntervalHistory> intervals{};
+                size_t intervalCount = 0;
+            };
+
+            Util::Logger s_logger("Input");
+
+            KeySet s_down;
+            KeySet s_pressed;
+            KeySet s_released;
+            SDL_Scancode s_lastPressed = SDL_SCANCODE_UNKNOWN;
+
+            Bindings s_bindings;
+            std::array<uint8_t, MaxActions> s_actionHolds{};
+            uint64_t s_actionsDown = 0;
+            uint64_t s_actionsPressed = 0;
+            uint64_t s_actionsReleased = 0;
+            std::vector<ActionEvent> s_actionEvents;
+            std::vector<Device> s_devices;
+
+            void SetAction(uint8_t action, bool down, uint64_t timestampNs, SDL_JoystickID device) {
+                if (action == NoAction) {
+                    return;
+                }
+
+                // Counted, so an action bound to two held inputs stays down until both let go
+                uint64_t bit = uint64_t{ 1 } << action;
+                if (down) {
+                    if (s_actionHolds[action]++ > 0) {
+                        return;
+                    }
+                    s_actionsDown |= bit;
+                    s_actionsPressed |= bit;
+                }
+                else {
+                    if (s_actionHolds[action] == 0 || --s_actionHolds[action] > 0) {
+                        return;
+                    }
+                    s_actionsDown &= ~bit;
+                    s_actionsReleased |= bit;
+                }
+                s_actionEvents.push_back(ActionEvent{ action, down, timestampNs, device });
+            }
+
+            void ResetActions() {
+                s_actionHolds.fill(0);
+                s_actionsDown = 0;
+                s_actionsPressed = 0;
+                s_actionsReleased = 0;
+                s_actionEvents.clear();
+            }
+
+            Device* FindDevice(SDL_JoystickID id) {
+                auto it = std::find_if(s_devices.begin(), s_devices.end(), [id](const Device& device) { return device.id == id; });
+                return it != s_devices.end() ? &*it : nullptr;
+            }
+
+            Device* OpenDevice(SDL_JoystickID id) {
+                if (Device* existing = FindDevice(id)) {
+                    return existing;
+                }
+
+                Device device;
+                device.id = id;
+                device.isVirtual = SDL_IsJoystickVirtual(id);
+                if (SDL_IsGamepad(id)) {
+                    device.gamepad = SDL_OpenGamepad(id);
+                }
+                else {
+                    device.joystick = SDL_OpenJoystick(id);
+                }
+                if (!device.gamepad && !device.joystick) {
+                    s_logger.Warn("Could not open controller {}: {}", id, SDL_GetError());
+                    return nullptr;
+                }
+
+                const char* name = device.gamepad ? SDL_GetGamepadName(device.gamepad) : SDL_GetJoystickName(device.joystick);
+                device.name = name ? name : "Unknown controller";
+                s_logger.Info("Opened {} '{}' (ID {})", device.gamepad ? "gamepad" : "joystick", device.name, id);
+                s_devices.push_back(std::move(device));
+                return &s_devices.back();
+            }
+
+            void CloseDevice(SDL_JoystickID id, uint64_t timestampNs) {
+                Device* device = FindDevice(id);
+                if (!device) {
+                    return;
+                }
+
+                // Buttons held as it went away never send their release
+                const uint8_t* bindings = device->gamepad ? s_bindings.gamepadButtons.data() : s_bindings.joystickButtons.data();
+                for (uint64_t held = device->held; held != 0; held &= held - 1) {
+                    SetAction(bindings[std::countr_zero(held)], false, timestampNs, id);
+                }
+
+                if (device->gamepad) {
+                    SDL_CloseGamepad(device->gamepad);
+                }
+                else {
+                    SDL_CloseJoystick(device->joystick);
+                }
+                s_logger.Info("Closed controller '{}' (ID {})", device->name, id);
+                s_devices.erase(s_devices.begin() + (device - s_devices.data()));
+            }
+
+            void OnButton(SDL_JoystickID id, bool gamepad, int button, bool down, uint64_t timestampNs) {
+                // Gamepads send a joystick event too, only the gamepad one counts for them
+                Device* device = FindDevice(id);
+                if (!device || (device->gamepad != nullptr) != gamepad || button < 0 || button >= MaxJoystickButtons) {
+                    return;
+                }
+
+                uint64_t bit = uint64_t{ 1 } << button;
+                if (((device->held & bit) != 0) == down) {
+                    return;
+                }
+                device->held ^= bit;
+                const uint8_t* bindings = gamepad ? s_bindings.gamepadButtons.data() : s_bindings.joystickButtons.data();
+                if (!gamepad || button < SDL_GAMEPAD_BUTTON_COUNT) {
+                    SetAction(bindings[button], down, timestampNs, id);
+                }
+            }
+
+            // Changes from one report share its timestamp, so each new timestamp is a report
+            void OnReport(SDL_JoystickID id, uint64_t timestampNs) {
+                Device* device = FindDevice(id);
+                if (!device || timestampNs <= device->lastReportNs) {
+                    return;
+                }
+
+                uint64_t interval = timestampNs - device->lastReportNs;
+                if (device->lastReportNs != 0 && interval < IdleGapNs) {
+                    device->intervals[device->intervalCount++ % IntervalHistory] = static_cast<uint32_t>(interval);
+                }
+                device->lastReportNs = timestampNs;
+                ++device->reports;
+            }
+        }
+
+        void BeginFrame() {
+            s_pressed = KeySet{};
+            s_released = KeySet{};
+            s_lastPressed = SDL_SCANCODE_UNKNOWN;
+            s_actionsPressed = 0;
+            s_actionsReleased = 0;
+            s_actionEvents.clear();
+        }
+
+        void HandleEvent(const SDL_Event& event) {
+            switch (event.type) {
+            case SDL_EVENT_KEY_DOWN:
+                if (event.key.scancode < SDL_SCANCODE_COUNT && !event.key.repeat && !s_down.Test(event.key.scancode)) {
+                    s_down.Set(event.key.scancode);
+                    s_pressed.Set(event.key.scancode);
+                    s_lastPressed = event.key.scancode;
+                    SetAction(s_bindings.keys[event.key.scancode], true, event.key.timestamp, 0);
+                }
+                break;
+            case SDL_EVENT_KEY_UP:
+                if (event.key.scancode < SDL_SCANCODE_COUNT && s_down.Test(event.key.scancode)) {
+                    s_down.Reset(event.key.scancode);
+                    s_released.Set(event.key.scancode);
+                    SetAction(s_bindings.keys[event.key.scancode], false, event.key.timestamp, 0);
+                }
+                break;
+            case SDL_EVENT_WINDOW_FOCUS_LOST:
+                // Keys let go in another window never send their release here
+                for (size_t word = 0; word < KeySet::Words; ++word) {
+                    for (uint64_t held = s_down.words[word]; held != 0; held &= held - 1) {
+                        int key = static_cast<int>(word * 64) + std::countr_zero(held);
+                        SetAction(s_bindings.keys[key], false, event.common.timestamp, 0);
+                    }
+                }
+                s_released = s_released | s_down;
+                s_down = KeySet{};
+                break;
+
+            // Controllers. Every joystick event arrives, gamepads send their own on top.
+            case SDL_EVENT_JOYSTICK_ADDED:
+                if (!SDL_IsGamepad(event.jdevice.which)) {
+                    OpenDevice(event.jdevice.which);
+                }
+                break;
+            case SDL_EVENT_GAMEPAD_ADDED:
+                OpenDevice(event.gdevice.which);
+                break;
+            case SDL_EVENT_JOYSTICK_REMOVED:
+            case SDL_EVENT_GAMEPAD_REMOVED:
+                CloseDevice(event.jdevice.which, event.common.timestamp);
+                break;
+            case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+            case SDL_EVENT_JOYSTICK_BUTTON_UP:
+                OnReport(event.jbutton.which, event.jbutton.timestamp);
+                OnButton(event.jbutton.which, false, event.jbutton.button, event.jbutton.down, event.jbutton.timestamp);
+                break;
+            case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+            case SDL_EVENT_GAMEPAD_BUTTON_UP:
+                OnButton(event.gbutton.which, true, event.gbutton.button, event.gbutton.down, event.gbutton.timestamp);
+                break;
+            case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+                OnReport(event.jaxis.which, event.jaxis.timestamp);
+                break;
+            case SDL_EVENT_JOYSTICK_HAT_MOTION:
+                OnReport(event.jhat.which, event.jhat.timestamp);
+                break;
+            case SDL_EVENT_JOYSTICK_BALL_MOTION:
+                OnReport(event.jball.which, event.jball.timestamp);
+                break;
+            default:
+                break;
+            }
+        }
+
         // Mouse
         Math::Vector2f GetMousePosition() {
             float x = 0, y = 0;
@@ -18,23 +274,168 @@ namespace Core {
         }
 
         // Keyboard
+        bool IsDown(SDL_Scancode key) {
+            return s_down.Test(key);
+        }
+
+        bool WasPressed(SDL_Scancode key) {
+            return s_pressed.Test(key);
+        }
+
+        bool WasReleased(SDL_Scancode key) {
+            return s_released.Test(key);
+        }
+
+        bool IsChordDown(const KeySet& chord) {
+            return s_down.Contains(chord);
+        }
+
+        bool WasChordPressed(const KeySet& chord) {
+            return s_down.Contains(chord) && s_pressed.Intersects(chord);
+        }
+
+        const KeySet& GetDownKeys() {
+            return s_down;
+        }
+
+        const KeySet& GetPressedKeys() {
+            return s_pressed;
+        }
+
+        const KeySet& GetReleasedKeys() {
+            return s_released;
+        }
+
         SDL_Scancode GetKeyPressed() {
-            SDL_Event event = Game::window->GetLastEvent();
-            if (event.type == SDL_EVENT_KEY_DOWN) {
-                return event.key.scancode;
-            }
-            return SDL_SCANCODE_UNKNOWN;
+            return s_lastPressed;
         }
 
         bool IsKeyDown(SDL_Scancode key) {
-            SDL_Event event = Game::window->GetLastEvent();
-            if (event.type == SDL_EVENT_KEY_DOWN) {
-                return event.key.scancode == key;
+            return IsDown(key);
+        }
+
+        /* ========================================================== */
+        /* Actions                                                    */
+        /* ========================================================== */
+        void Bind(BindingSource source, int code, int action) {
+            uint8_t* slot = s_bindings.Find(source, code);
+            if (!slot || action < 0 || action >= MaxActions) {
+                s_logger.Error("Cannot bind code {} to action {}", code, action);
+                return;
             }
-            else if (event.type == SDL_EVENT_KEY_UP) {
-                return false; // Key is not down if it's released
+            // Held inputs would come back up against the new table
+            ResetActions();
+            *slot = static_cast<uint8_t>(action);
+        }
+
+        void ClearBindings() {
+            ResetActions();
+            s_bindings.Clear();
+        }
+
+        bool IsActionDown(int action) {
+            return (s_actionsDown >> action) & 1;
+        }
+
+        bool WasActionPressed(int action) {
+            return (s_actionsPressed >> action) & 1;
+        }
+
+        bool WasActionReleased(int action) {
+            return (s_actionsReleased >> action) & 1;
+        }
+
+        uint64_t GetActionsDown() {
+            return s_actionsDown;
+        }
+
+        const std::vector<ActionEvent>& GetActionEvents() {
+            return s_actionEvents;
+        }
+
+        /* ========================================================== */
+        /* Controllers                                                */
+        /* ========================================================== */
+        bool IsGamepadButtonDown(SDL_GamepadButton button) {
+            if (button < 0 || button >= SDL_GAMEPAD_BUTTON_COUNT) {
+                return false;
+            }
+            uint64_t bit = uint64_t{ 1 } << button;
+            return std::any_of(s_devices.begin(), s_devices.end(),
+                [bit](const Device& device) { return device.gamepad && (device.held & bit) != 0; });
+        }
+
+        std::vector<DeviceStats> GetDeviceStats() {
+            std::vector<DeviceStats> stats;
+            stats.reserve(s_devices.size());
+            for (const Device& device : s_devices) {
+                DeviceStats& entry = stats.emplace_back();
+                entry.id = device.id;
+                entry.name = device.name;
+                entry.gamepad = device.gamepad != nullptr;
+                entry.isVirtual = device.isVirtual;
+                entry.reports = device.reports;
+
+                size_t count = std::min(device.intervalCount, IntervalHistory);
+                if (count < MinIntervals) {
+                    continue;
+                }
+
+                // Reports skipped because nothing changed show up as multiples of the
+                // period, so only intervals close to the median count
+                std::vector<uint32_t> intervals(device.intervals.begin(), device.intervals.begin() + count);
+                std::nth_element(intervals.begin(), intervals.begin() + count / 2, intervals.end());
+                double median = intervals[count / 2];
+                double sum = 0.0;
+                double squares = 0.0;
+                size_t near = 0;
+                for (uint32_t interval : intervals) {
+                    if (interval > median * 0.5 && interval < median * 1.5) {
+                        sum += interval;
+                        squares += static_cast<double>(interval) * interval;
+                        ++near;
+                    }
+                }
+                double period = sum / near;
+                entry.rateHz = 1e9 / period;
+                entry.jitterMs = std::sqrt(std::max(0.0, squares / near - period * period)) / 1e6;
+            }
+            return stats;
+        }
+
+        SDL_JoystickID AttachVirtualJoystick(const char* name, int buttons, int axes) {
+            SDL_VirtualJoystickDesc desc;
+            SDL_INIT_INTERFACE(&desc);
+            desc.type = SDL_JOYSTICK_TYPE_ARCADE_PAD;
+            desc.nbuttons = static_cast<Uint16>(buttons);
+            desc.naxes = static_cast<Uint16>(axes);
+            desc.name = name;
+
+            SDL_JoystickID id = SDL_AttachVirtualJoystick(&desc);
+            if (id == 0) {
+                s_logger.Error("Could not attach virtual joystick '{}': {}", name, SDL_GetError());
+            }
+            return id;
+        }
+
+        bool SetVirtualButton(SDL_JoystickID device, int button, bool down) {
+            // Its added event may not have been handled yet
+            Device* opened = OpenDevice(device);
+            SDL_Joystick* joystick = opened ? SDL_GetJoystickFromID(device) : nullptr;
+            return joystick && SDL_SetJoystickVirtualButton(joystick, button, down);
+        }
+
+        bool SetVirtualAxis(SDL_JoystickID device, int axis, int16_t value) {
+            Device* opened = OpenDevice(device);
+            SDL_Joystick* joystick = opened ? SDL_GetJoystickFromID(device) : nullptr;
+            return joystick && SDL_SetJoystickVirtualAxis(joystick, axis, value);
+        }
+
+        void DetachVirtualJoystick(SDL_JoystickID device) {
+            CloseDevice(device, SDL_GetTicksNS());
+            if (!SDL_DetachVirtualJoystick(device)) {
+                s_logger.Error("Could not detach virtual joystick {}: {}", device, SDL_GetError());
             }
-            return false;
         }
     }
 }
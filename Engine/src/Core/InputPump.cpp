@@ -0,0 +1,63 @@
+#include <Core/InputPump.hpp>
+#include <Core/Latency.hpp>
+
+using namespace Core;
+
+InputPump::InputPump()
+    : m_queue(Capacity), m_wakeEvent(SDL_RegisterEvents(1)), m_logger("InputPump") {
+}
+
+void InputPump::Run() {
+    if (!SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_HIGH)) {
+        m_logger.Warn("Could not raise input thread priority: {}", SDL_GetError());
+    }
+    m_logger.Info("Pumping input on the main thread");
+
+    LatencyTracker& latency = LatencyTracker::Get();
+    SDL_Event event;
+    while (!m_stopping.load(std::memory_order_acquire)) {
+        // Blocks in the OS until something arrives. The timeout only bounds
+        // how long Stop() takes if its wake event couldn't be registered.
+        if (!SDL_WaitEventTimeout(&event, 100)) {
+            continue;
+        }
+
+        do {
+            uint64_t now = SDL_GetTicksNS();
+            if (m_wakeEvent != 0 && event.type == m_wakeEvent) {
+                continue;
+            }
+            if (event.type == SDL_EVENT_QUIT) {
+                m_quitRequested.store(true, std::memory_order_release);
+            }
+            if (LatencyTracker::IsTracked(event)) {
+                latency.OnPolled(event, now);
+            }
+            if (!m_queue.TryPush(InputEvent{ event, now })) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        } while (SDL_PollEvent(&event));
+    }
+    m_logger.Info("Input pump stopped");
+}
+
+void InputPump::Stop() {
+    m_stopping.store(true, std::memory_order_release);
+    if (m_wakeEvent != 0) {
+        SDL_Event wake{};
+        wake.type = m_wakeEvent;
+        SDL_PushEvent(&wake);
+    }
+}
+
+bool InputPump::Pop(InputEvent& event) {
+    return m_queue.TryPop(event);
+}
+
+bool InputPump::IsQuitRequested() const {
+    return m_quitRequested.load(std::memory_order_acquire);
+}
+
+uint64_t InputPump::GetDroppedCount() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,174 @@
+#include <Core/Latency.hpp>
+#include <algorithm>
+
+using namespace Core;
+
+/* ============================================================== */
+/* Histogram                                                      */
+/* ============================================================== */
+void LatencyHistogram::Add(uint64_t ns) {
+    size_t bucket = std::min<uint64_t>(ns / BucketNs, BucketCount - 1);
+    ++m_buckets[bucket];
+    ++m_count;
+    m_totalNs += ns;
+    m_maxNs = std::max(m_maxNs, ns);
+}
+
+void LatencyHistogram::Clear() {
+    *this = LatencyHistogram{};
+}
+
+uint64_t LatencyHistogram::GetCount() const {
+    return m_count;
+}
+
+double LatencyHistogram::GetMeanMs() const {
+    return m_count > 0 ? static_cast<double>(m_totalNs) / m_count / 1e6 : 0.0;
+}
+
+double LatencyHistogram::GetMaxMs() const {
+    return static_cast<double>(m_maxNs) / 1e6;
+}
+
+double LatencyHistogram::GetPercentileMs(double p) const {
+    if (m_count == 0) {
+        return 0.0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(std::clamp(p, 0.0, 1.0) * (m_count - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BucketCount - 1; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            return std::min(static_cast<double>((i + 1) * BucketNs), static_cast<double>(m_maxNs)) / 1e6;
+        }
+    }
+    return GetMaxMs();
+}
+
+const std::array<uint32_t, LatencyHistogram::BucketCount>& LatencyHistogram::GetBuckets() const {
+    return m_buckets;
+}
+
+/* ============================================================== */
+/* Tracker                                                        */
+/* ============================================================== */
+LatencyTracker::LatencyTracker()
+    : m_logger("Latency") {
+}
+
+LatencyTracker& LatencyTracker::Get() {
+    static LatencyTracker tracker;
+    return tracker;
+}
+
+const char* LatencyTracker::GetStageName(Stage stage) {
+    switch (stage) {
+    case Queue: return "Queue";
+    case Consume: return "Consume";
+    case Submit: return "Submit";
+    case Present: return "Present";
+    case Total: return "Total";
+    default: return "Unknown";
+    }
+}
+
+bool LatencyTracker::IsTracked(const SDL_Event& event) {
+    switch (event.type) {
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+    case SDL_EVENT_MOUSE_WHEEL:
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP:
+    case SDL_EVENT_FINGER_DOWN:
+    case SDL_EVENT_FINGER_UP:
+        return true;
+    case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+    case SDL_EVENT_JOYSTICK_BUTTON_UP:
+        // A gamepad press comes as both, count it once
+        return !SDL_IsGamepad(event.jbutton.which);
+    default:
+        return false;
+    }
+}
+
+void LatencyTracker::OnPolled(const SDL_Event& event, uint64_t polledNs) {
+    // Events SDL didn't stamp count from the poll
+    uint64_t eventNs = event.common.timestamp != 0 ? std::min<uint64_t>(event.common.timestamp, polledNs) : polledNs;
+
+    std::lock_guard lock(m_mutex);
+    if (m_polled.size() >= MaxPending) {
+        m_polled.erase(m_polled.begin());
+    }
+    m_polled.push_back(Sample{ eventNs, polledNs, 0, 0, 0 });
+}
+
+void LatencyTracker::OnConsumed() {
+    uint64_t now = SDL_GetTicksNS();
+
+    std::lock_guard lock(m_mutex);
+    for (Sample& sample : m_polled) {
+        sample.consumedNs = now;
+        m_consumed.push_back(sample);
+    }
+    m_polled.clear();
+}
+
+uint64_t LatencyTracker::OnSubmitted() {
+    uint64_t now = SDL_GetTicksNS();
+
+    std::lock_guard lock(m_mutex);
+    uint64_t frame = m_nextFrame++;
+    for (Sample& sample : m_consumed) {
+        sample.submittedNs = now;
+        sample.frame = frame;
+        m_submitted.push_back(sample);
+    }
+    m_consumed.clear();
+    return frame;
+}
+
+void LatencyTracker::OnPresented(uint64_t frameSerial, uint64_t presentedNs) {
+    std::lock_guard lock(m_mutex);
+    // Submitted in order, so everything up to this frame is on screen now
+    auto shown = std::find_if(m_submitted.begin(), m_submitted.end(),
+        [frameSerial](const Sample& sample) { return sample.frame > frameSerial; });
+    for (auto it = m_submitted.begin(); it != shown; ++it) {
+        m_histograms[Queue].Add(it->polledNs - it->eventNs);
+        m_histograms[Consume].Add(it->consumedNs - it->polledNs);
+        m_histograms[Submit].Add(it->submittedNs - it->consumedNs);
+        m_histograms[Present].Add(presentedNs - it->submittedNs);
+        m_histograms[Total].Add(presentedNs - it->eventNs);
+    }
+    m_submitted.erase(m_submitted.begin(), shown);
+}
+
+LatencyTracker::Histograms LatencyTracker::GetHistograms() const {
+    std::lock_guard lock(m_mutex);
+    return m_histograms;
+}
+
+void LatencyTracker::Reset() {
+    std::lock_guard lock(m_mutex);
+    for (LatencyHistogram& histogram : m_histograms) {
+        histogram.Clear();
+    }
+}
+
+void LatencyTracker::LogSummary() {
+    Histograms histograms = GetHistograms();
+    if (histograms[Total].GetCount() == 0) {
+        m_logger.Info("No input events recorded");
+        return;
+    }
+
+    m_logger.Info("Input latency over {} events (ms):", histograms[Total].GetCount());
+    for (int stage = 0; stage < StageCount; ++stage) {
+        const LatencyHistogram& histogram = histograms[stage];
+        m_logger.Info("  {:<8} mean {:6.2f}  p50 {:6.2f}  p95 {:6.2f}  p99 {:6.2f}  max {:6.2f}",
+            GetStageName(static_cast<Stage>(stage)), histogram.GetMeanMs(), histogram.GetPercentileMs(0.5),
+            histogram.GetPercentileMs(0.95), histogram.GetPercentileMs(0.99), histogram.GetMaxMs());
+    }
+}
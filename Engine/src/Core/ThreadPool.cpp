@@ -0,0 +1,131 @@
+#include <Core/ThreadPool.hpp>
+#include <Util/Log.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <exception>
+
+using namespace Core;
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        size_t hardware = std::thread::hardware_concurrency();
+        threadCount = std::clamp<size_t>(hardware > 2 ? hardware - 2 : 1, 1, 8);
+    }
+
+    m_threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back(&ThreadPool::WorkerMain, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+}
+
+void ThreadPool::WaitIdle() {
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_tasks.empty() && m_active == 0; });
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+    struct Batch {
+        std::atomic<size_t> next{ 0 };
+        size_t done = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto batch = std::make_shared<Batch>();
+
+    // Helpers that start after the work ran out find nothing to take and return
+    auto run = [batch, count, &body] {
+        size_t ran = 0;
+        std::exception_ptr error;
+        for (size_t i = batch->next++; i < count; i = batch->next++) {
+            try {
+                body(i);
+            }
+            catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            ++ran;
+        }
+        if (ran == 0) {
+            return;
+        }
+
+        std::lock_guard lock(batch->mutex);
+        batch->done += ran;
+        if (error && !batch->error) {
+            batch->error = error;
+        }
+        if (batch->done == count) {
+            batch->finished.notify_all();
+        }
+    };
+
+    size_t helpers = std::min(m_threads.size(), count > 0 ? count - 1 : 0);
+    for (size_t i = 0; i < helpers; ++i) {
+        Submit(run);
+    }
+    run();
+
+    std::unique_lock lock(batch->mutex);
+    batch->finished.wait(lock, [&] { return batch->done == count; });
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+}
+
+size_t ThreadPool::GetThreadCount() const {
+    return m_threads.size();
+}
+
+void ThreadPool::WorkerMain() {
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+        if (m_tasks.empty()) {
+            return; // stopping and drained
+        }
+
+        std::function<void()> task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        ++m_active;
+        lock.unlock();
+
+        try {
+            task();
+        }
+        catch (const std::exception& e) {
+            Util::Logger("ThreadPool").Error("Task threw: {}", e.what());
+        }
+        catch (...) {
+            Util::Logger("ThreadPool").Error("Task threw an unknown exception");
+        }
+
+        lock.lock();
+        --m_active;
+        if (m_tasks.empty() && m_active == 0) {
+            m_idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#include <Physics/Collision.hpp>
+#include <algorithm>
+
+namespace Physics {
+    AABB::AABB(const Math::Vector2f& min, const Math::Vector2f& max) : min(min), max(max) {}
+
+    AABB AABB::FromCenter(const Math::Vector2f& center, const Math::Vector2f& size) {
+        Math::Vector2f half = size * 0.5f;
+        return AABB(center - half, center + half);
+    }
+
+    Math::Vector2f AABB::Center() const {
+        return (min + max) * 0.5f;
+    }
+
+    Math::Vector2f AABB::Size() const {
+        return max - min;
+    }
+
+    Circle::Circle(const Math::Vector2f& center, float radius) : center(center), radius(radius) {}
+
+    AABB Circle::Bounds() const {
+        Math::Vector2f r(radius, radius);
+        return AABB(center - r, center + r);
+    }
+
+    bool Contains(const AABB& box, const Math::Vector2f& point) {
+        return point.x >= box.min.x && point.x <= box.max.x &&
+            point.y >= box.min.y && point.y <= box.max.y;
+    }
+
+    bool Contains(const Circle& circle, const Math::Vector2f& point) {
+        Math::Vector2f d = point - circle.center;
+        return d.x * d.x + d.y * d.y <= circle.radius * circle.radius;
+    }
+
+    bool Intersects(const AABB& a, const AABB& b) {
+        return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+            a.min.y <= b.max.y && a.max.y >= b.min.y;
+    }
+
+    bool Intersects(const Circle& a, const Circle& b) {
+        Math::Vector2f d = b.center - a.center;
+        float r = a.radius + b.radius;
+        return d.x * d.x + d.y * d.y <= r * r;
+    }
+
+    bool Intersects(const AABB& box, const Circle& circle) {
+        // Closest point on the box to the circle center
+        float cx = std::clamp(circle.center.x, box.min.x, box.max.x);
+        float cy = std::clamp(circle.center.y, box.min.y, box.max.y);
+        float dx = circle.center.x - cx;
+        float dy = circle.center.y - cy;
+        return dx * dx + dy * dy <= circle.radius * circle.radius;
+    }
+}
@@ -0,0 +1,409 @@
+#include <Physics/SpatialHash.hpp>
+#include <Math/Simd.hpp>
+#include <Core/Exceptions.hpp>
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <string>
+
+using namespace Physics;
+
+namespace {
+    // Cell coordinates are clamped to this many cells either side of the
+    // origin, so they always fit the 32-bit halves of a cell key
+    constexpr float MaxCell = static_cast<float>(1 << 24);
+}
+
+SpatialHash::SpatialHash(float cellSize)
+    : m_cellSize(cellSize), m_invCellSize(0.0f) {
+    if (cellSize <= 0.0f) {
+        throw Core::Exception("SpatialHash: cell size must be positive");
+    }
+    m_invCellSize = 1.0f / cellSize;
+}
+
+/* ============================================================== */
+/* Body management                                                */
+/* ============================================================== */
+BodyID SpatialHash::Allocate() {
+    if (!m_freeList.empty()) {
+        BodyID id = m_freeList.back();
+        m_freeList.pop_back();
+        m_order[id] = m_nextOrder++;
+        return id;
+    }
+
+    BodyID id = static_cast<BodyID>(m_shape.size());
+    m_minX.push_back(0.0f);
+    m_minY.push_back(0.0f);
+    m_maxX.push_back(0.0f);
+    m_maxY.push_back(0.0f);
+    m_radius.push_back(0.0f);
+    m_shape.push_back(Shape::None);
+    m_ranges.push_back(CellRange{});
+    m_order.push_back(m_nextOrder++);
+    return id;
+}
+
+void SpatialHash::SetBody(BodyID id, Shape shape, const AABB& bounds, float radius) {
+    m_minX[id] = bounds.min.x;
+    m_minY[id] = bounds.min.y;
+    m_maxX[id] = bounds.max.x;
+    m_maxY[id] = bounds.max.y;
+    m_radius[id] = radius;
+    m_shape[id] = shape;
+
+    CellRange range = ComputeRange(bounds);
+    if (range != m_ranges[id]) {
+        RemoveFromCells(id, m_ranges[id]);
+        AddToCells(id, range);
+        m_ranges[id] = range;
+    }
+}
+
+BodyID SpatialHash::Insert(const AABB& box) {
+    CheckBounds(box, "SpatialHash::Insert");
+    BodyID id = Allocate();
+    m_ranges[id] = CellRange{};
+    SetBody(id, Shape::Box, box, 0.0f);
+    ++m_bodyCount;
+    return id;
+}
+
+BodyID SpatialHash::Insert(const Circle& circle) {
+    CheckBounds(circle.Bounds(), "SpatialHash::Insert");
+    BodyID id = Allocate();
+    m_ranges[id] = CellRange{};
+    SetBody(id, Shape::Circle, circle.Bounds(), circle.radius);
+    ++m_bodyCount;
+    return id;
+}
+
+void SpatialHash::Update(BodyID id, const AABB& box) {
+    if (!IsValid(id)) {
+        throw Core::Exception("SpatialHash::Update: invalid body ID");
+    }
+    CheckBounds(box, "SpatialHash::Update");
+    SetBody(id, Shape::Box, box, 0.0f);
+}
+
+void SpatialHash::Update(BodyID id, const Circle& circle) {
+    if (!IsValid(id)) {
+        throw Core::Exception("SpatialHash::Update: invalid body ID");
+    }
+    CheckBounds(circle.Bounds(), "SpatialHash::Update");
+    SetBody(id, Shape::Circle, circle.Bounds(), circle.radius);
+}
+
+void SpatialHash::Remove(BodyID id) {
+    if (!IsValid(id)) {
+        throw Core::Exception("SpatialHash::Remove: invalid body ID");
+    }
+    RemoveFromCells(id, m_ranges[id]);
+    m_ranges[id] = CellRange{};
+    m_shape[id] = Shape::None;
+    m_freeList.push_back(id);
+    --m_bodyCount;
+}
+
+void SpatialHash::Clear() {
+    m_minX.clear();
+    m_minY.clear();
+    m_maxX.clear();
+    m_maxY.clear();
+    m_radius.clear();
+    m_shape.clear();
+    m_ranges.clear();
+    m_order.clear();
+    m_freeList.clear();
+    m_cells.clear();
+    m_bodyCount = 0;
+    m_nextOrder = 0;
+}
+
+/* ============================================================== */
+/* Grid helpers                                                   */
+/* ============================================================== */
+uint64_t SpatialHash::CellKey(int32_t x, int32_t y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+int32_t SpatialHash::ToCell(float coord) const {
+    // Clamped before the cast, which is undefined out of range. NaN fails both
+    // comparisons and lands on the low edge.
+    float cell = std::floor(coord * m_invCellSize);
+    if (!(cell >= -MaxCell)) {
+        cell = -MaxCell;
+    }
+    else if (cell > MaxCell) {
+        cell = MaxCell;
+    }
+    return static_cast<int32_t>(cell);
+}
+
+int64_t SpatialHash::CellRange::Count() const {
+    if (maxX < minX || maxY < minY) {
+        return 0;
+    }
+    return (static_cast<int64_t>(maxX) - minX + 1) * (static_cast<int64_t>(maxY) - minY + 1);
+}
+
+void SpatialHash::CheckBounds(const AABB& bounds, const char* caller) const {
+    if (!std::isfinite(bounds.min.x) || !std::isfinite(bounds.min.y) || !std::isfinite(bounds.max.x) || !std::isfinite(bounds.max.y)) {
+        throw Core::Exception(std::string(caller) + ": bounds are not finite");
+    }
+    int64_t cells = ComputeRange(bounds).Count();
+    if (cells > MaxCellsPerBody) {
+        throw Core::Exception(std::format("{}: body covers {} cells, the limit is {}", caller, cells, MaxCellsPerBody));
+    }
+}
+
+SpatialHash::CellRange SpatialHash::ComputeRange(const AABB& bounds) const {
+    return CellRange{ ToCell(bounds.min.x), ToCell(bounds.min.y), ToCell(bounds.max.x), ToCell(bounds.max.y) };
+}
+
+void SpatialHash::AddToCells(BodyID id, const CellRange& range) {
+    for (int32_t y = range.minY; y <= range.maxY; ++y) {
+        for (int32_t x = range.minX; x <= range.maxX; ++x) {
+            m_cells[CellKey(x, y)].push_back(id);
+        }
+    }
+}
+
+void SpatialHash::RemoveFromCells(BodyID id, const CellRange& range) {
+    for (int32_t y = range.minY; y <= range.maxY; ++y) {
+        for (int32_t x = range.minX; x <= range.maxX; ++x) {
+            auto it = m_cells.find(CellKey(x, y));
+            if (it == m_cells.end()) {
+                continue;
+            }
+
+            std::vector<BodyID>& bodies = it->second;
+            auto pos = std::find(bodies.begin(), bodies.end(), id);
+            if (pos != bodies.end()) {
+                *pos = bodies.back();
+                bodies.pop_back();
+            }
+            if (bodies.empty()) {
+                m_cells.erase(it);
+            }
+        }
+    }
+}
+
+/* ============================================================== */
+/* Queries                                                        */
+/* ============================================================== */
+bool SpatialHash::ContainsPoint(BodyID id, const Math::Vector2f& point) const {
+    AABB bounds = GetBounds(id);
+    if (m_shape[id] == Shape::Circle) {
+        return Contains(Circle(bounds.Center(), m_radius[id]), point);
+    }
+    return Contains(bounds, point);
+}
+
+void SpatialHash::QueryPoint(const Math::Vector2f& point, std::vector<BodyID>& out) const {
+    auto it = m_cells.find(CellKey(ToCell(point.x), ToCell(point.y)));
+    if (it == m_cells.end()) {
+        return;
+    }
+    for (BodyID id : it->second) {
+        if (ContainsPoint(id, point)) {
+            out.push_back(id);
+        }
+    }
+}
+
+void SpatialHash::QueryBox(const AABB& box, std::vector<BodyID>& out) const {
+    CellRange range = ComputeRange(box);
+    auto visit = [&](int32_t x, int32_t y, const std::vector<BodyID>& bodies) {
+        for (BodyID id : bodies) {
+            const CellRange& r = m_ranges[id];
+            // Only report a body from the first cell of the query it touches
+            if (std::max(r.minX, range.minX) != x || std::max(r.minY, range.minY) != y) {
+                continue;
+            }
+            if (Intersects(GetBounds(id), box)) {
+                out.push_back(id);
+            }
+        }
+    };
+
+    if (range.Count() > static_cast<int64_t>(m_cells.size())) {
+        for (const auto& [key, bodies] : m_cells) {
+            int32_t x = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+            int32_t y = static_cast<int32_t>(static_cast<uint32_t>(key));
+            if (x >= range.minX && x <= range.maxX && y >= range.minY && y <= range.maxY) {
+                visit(x, y, bodies);
+            }
+        }
+        return;
+    }
+
+    for (int32_t y = range.minY; y <= range.maxY; ++y) {
+        for (int32_t x = range.minX; x <= range.maxX; ++x) {
+            auto it = m_cells.find(CellKey(x, y));
+            if (it != m_cells.end()) {
+                visit(x, y, it->second);
+            }
+        }
+    }
+}
+
+std::optional<BodyID> SpatialHash::Pick(const Math::Vector2f& point) const {
+    auto it = m_cells.find(CellKey(ToCell(point.x), ToCell(point.y)));
+    if (it == m_cells.end()) {
+        return std::nullopt;
+    }
+
+    std::optional<BodyID> best;
+    for (BodyID id : it->second) {
+        if ((!best.has_value() || m_order[id] > m_order[best.value()]) && ContainsPoint(id, point)) {
+            best = id;
+        }
+    }
+    return best;
+}
+
+/* ============================================================== */
+/* Broad and narrow phase                                         */
+/* ============================================================== */
+void SpatialHash::FindPairs(std::vector<BodyPair>& out) const {
+    for (const auto& [key, bodies] : m_cells) {
+        int32_t cellX = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+        int32_t cellY = static_cast<int32_t>(static_cast<uint32_t>(key));
+
+        for (size_t i = 0; i < bodies.size(); ++i) {
+            const CellRange& ra = m_ranges[bodies[i]];
+            for (size_t j = i + 1; j < bodies.size(); ++j) {
+                const CellRange& rb = m_ranges[bodies[j]];
+                // Two bodies can share several cells; only the top-left shared cell reports them
+                if (std::max(ra.minX, rb.minX) != cellX || std::max(ra.minY, rb.minY) != cellY) {
+                    continue;
+                }
+                BodyID a = std::min(bodies[i], bodies[j]);
+                BodyID b = std::max(bodies[i], bodies[j]);
+                out.push_back(BodyPair{ a, b });
+            }
+        }
+    }
+}
+
+bool SpatialHash::IntersectsScalar(BodyID a, BodyID b) const {
+    AABB ba = GetBounds(a);
+    AABB bb = GetBounds(b);
+    bool circleA = m_shape[a] == Shape::Circle;
+    bool circleB = m_shape[b] == Shape::Circle;
+
+    if (circleA && circleB) {
+        return Intersects(Circle(ba.Center(), m_radius[a]), Circle(bb.Center(), m_radius[b]));
+    }
+    if (circleA) {
+        return Intersects(bb, Circle(ba.Center(), m_radius[a]));
+    }
+    if (circleB) {
+        return Intersects(ba, Circle(bb.Center(), m_radius[b]));
+    }
+    return Intersects(ba, bb);
+}
+
+void SpatialHash::FilterPairs(std::vector<BodyPair>& pairs) const {
+    using Math::Simd::Float4;
+
+    size_t count = pairs.size();
+    size_t kept = 0;
+    size_t i = 0;
+
+    const Float4 half(0.5f);
+    const Float4 zero(0.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        float aMinX[4], aMinY[4], aMaxX[4], aMaxY[4], aRad[4];
+        float bMinX[4], bMinY[4], bMaxX[4], bMaxY[4], bRad[4];
+        for (int k = 0; k < 4; ++k) {
+            BodyID a = pairs[i + k].a;
+            BodyID b = pairs[i + k].b;
+            aMinX[k] = m_minX[a]; aMinY[k] = m_minY[a]; aMaxX[k] = m_maxX[a]; aMaxY[k] = m_maxY[a];
+            bMinX[k] = m_minX[b]; bMinY[k] = m_minY[b]; bMaxX[k] = m_maxX[b]; bMaxY[k] = m_maxY[b];
+            aRad[k] = m_shape[a] == Shape::Circle ? m_radius[a] : 0.0f;
+            bRad[k] = m_shape[b] == Shape::Circle ? m_radius[b] : 0.0f;
+        }
+
+        Float4 a0x = Float4::Load(aMinX), a0y = Float4::Load(aMinY);
+        Float4 a1x = Float4::Load(aMaxX), a1y = Float4::Load(aMaxY);
+        Float4 b0x = Float4::Load(bMinX), b0y = Float4::Load(bMinY);
+        Float4 b1x = Float4::Load(bMaxX), b1y = Float4::Load(bMaxY);
+
+        // Bounds overlap for all 4 pairs at once
+        Float4 boxHit = (a0x <= b1x) & (b0x <= a1x) & (a0y <= b1y) & (b0y <= a1y);
+
+        // Circle vs circle distance test, also 4-wide
+        Float4 ra = Float4::Load(aRad);
+        Float4 rb = Float4::Load(bRad);
+        Float4 dx = (a0x + a1x) * half - (b0x + b1x) * half;
+        Float4 dy = (a0y + a1y) * half - (b0y + b1y) * half;
+        Float4 rs = ra + rb;
+        Float4 circleHit = (dx * dx + dy * dy) <= (rs * rs);
+        Float4 bothCircles = (zero < ra) & (zero < rb);
+
+        int boxMask = boxHit.Mask();
+        int circleMask = circleHit.Mask();
+        int bothMask = bothCircles.Mask();
+        int anyCircleMask = ((zero < ra) | (zero < rb)).Mask();
+
+        for (int k = 0; k < 4; ++k) {
+            int bit = 1 << k;
+            bool hit;
+            if (bothMask & bit) {
+                hit = (circleMask & bit) != 0;
+            }
+            else if (anyCircleMask & bit) {
+                // Box vs circle: bounds reject in SIMD, exact test only for survivors
+                hit = (boxMask & bit) && IntersectsScalar(pairs[i + k].a, pairs[i + k].b);
+            }
+            else {
+                hit = (boxMask & bit) != 0;
+            }
+            if (hit) {
+                pairs[kept++] = pairs[i + k];
+            }
+        }
+    }
+
+    for (; i < count; ++i) {
+        if (IntersectsScalar(pairs[i].a, pairs[i].b)) {
+            pairs[kept++] = pairs[i];
+        }
+    }
+
+    pairs.resize(kept);
+}
+
+void SpatialHash::Collide(std::vector<BodyPair>& out) const {
+    out.clear();
+    FindPairs(out);
+    FilterPairs(out);
+}
+
+/* ============================================================== */
+/* Accessors                                                      */
+/* ============================================================== */
+AABB SpatialHash::GetBounds(BodyID id) const {
+    return AABB(Math::Vector2f(m_minX[id], m_minY[id]), Math::Vector2f(m_maxX[id], m_maxY[id]));
+}
+
+bool SpatialHash::IsValid(BodyID id) const {
+    return id < m_shape.size() && m_shape[id] != Shape::None;
+}
+
+size_t SpatialHash::GetBodyCount() const {
+    return m_bodyCount;
+}
+
+size_t SpatialHash::GetCellCount() const {
+    return m_cells.size();
+}
+
+float SpatialHash::GetCellSize() const {
+    return m_cellSize;
+}
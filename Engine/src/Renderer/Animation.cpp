@@ -0,0 +1,263 @@
+#include <Renderer/Animation.hpp>
+#include <Math/Simd.hpp>
+#include <Core/Exceptions.hpp>
+#include <algorithm>
+
+using namespace Renderer;
+
+/* ============================================================== */
+/* Sprite sheets                                                  */
+/* ============================================================== */
+SpriteSheet SpriteSheet::FromGrid(const TextureData& texture, const Math::Vector2f& frameSize, uint32_t frameCount) {
+    if (frameSize.x <= 0.0f || frameSize.y <= 0.0f) {
+        throw Core::Exception("SpriteSheet::FromGrid: frame size must be positive");
+    }
+
+    uint32_t columns = static_cast<uint32_t>(texture.size.x / frameSize.x);
+    uint32_t rows = static_cast<uint32_t>(texture.size.y / frameSize.y);
+    uint32_t cells = columns * rows;
+    if (cells == 0) {
+        throw Core::Exception("SpriteSheet::FromGrid: frame size is larger than the texture");
+    }
+    if (frameCount == 0 || frameCount > cells) {
+        frameCount = cells;
+    }
+
+    SpriteSheet sheet;
+    sheet.texture = texture.id;
+    sheet.frames.reserve(frameCount);
+
+    float du = frameSize.x / texture.size.x;
+    float dv = frameSize.y / texture.size.y;
+    for (uint32_t i = 0; i < frameCount; ++i) {
+        float u = static_cast<float>(i % columns) * du;
+        float v = static_cast<float>(i / columns) * dv;
+        sheet.frames.push_back(UVRect{ u, v, u + du, v + dv });
+    }
+    return sheet;
+}
+
+/* ============================================================== */
+/* Clips and instances                                            */
+/* ============================================================== */
+AnimationSystem::AnimationSystem() = default;
+
+ClipID AnimationSystem::AddClip(const SpriteSheet& sheet, uint32_t firstFrame, uint32_t frameCount, float fps, bool loop) {
+    if (frameCount == 0 || firstFrame + frameCount > sheet.frames.size()) {
+        throw Core::Exception("AnimationSystem::AddClip: frame range is outside the sprite sheet");
+    }
+    if (fps <= 0.0f) {
+        throw Core::Exception("AnimationSystem::AddClip: fps must be positive");
+    }
+
+    Clip clip{ sheet.texture, static_cast<uint32_t>(m_frameUVs.size()), frameCount, fps, loop };
+    m_frameUVs.insert(m_frameUVs.end(), sheet.frames.begin() + firstFrame, sheet.frames.begin() + firstFrame + frameCount);
+    m_clips.push_back(clip);
+    return static_cast<ClipID>(m_clips.size() - 1);
+}
+
+AnimationID AnimationSystem::Play(ClipID clipID, const Math::Vector2f& pos, const Math::Vector2f& size, float speed, uint32_t color) {
+    if (clipID >= m_clips.size()) {
+        throw Core::Exception("AnimationSystem::Play: unknown clip");
+    }
+    // Frames are never stepped backwards; NaN fails this too
+    if (!(speed >= 0.0f)) {
+        throw Core::Exception("AnimationSystem::Play: speed must not be negative");
+    }
+    const Clip& clip = m_clips[clipID];
+
+    uint32_t index = static_cast<uint32_t>(m_time.size());
+    m_time.push_back(0.0f);
+    m_speed.push_back(speed);
+    m_fps.push_back(clip.fps);
+    m_frameCount.push_back(static_cast<float>(clip.frameCount));
+    m_invFrameCount.push_back(1.0f / static_cast<float>(clip.frameCount));
+    m_duration.push_back(static_cast<float>(clip.frameCount) / clip.fps);
+    m_loop.push_back(clip.loop ? 1.0f : 0.0f);
+    m_frame.push_back(0);
+    m_finished.push_back(0);
+    m_clip.push_back(clipID);
+    m_posX.push_back(pos.x);
+    m_posY.push_back(pos.y);
+    m_sizeX.push_back(size.x);
+    m_sizeY.push_back(size.y);
+    m_color.push_back(color);
+
+    AnimationID handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        m_handleToIndex[handle] = index;
+    }
+    else {
+        handle = static_cast<AnimationID>(m_handleToIndex.size());
+        m_handleToIndex.push_back(index);
+    }
+    m_indexToHandle.push_back(handle);
+    return handle;
+}
+
+void AnimationSystem::RemoveAt(uint32_t index) {
+    uint32_t last = static_cast<uint32_t>(m_time.size() - 1);
+    AnimationID removed = m_indexToHandle[index];
+
+    if (index != last) {
+        m_time[index] = m_time[last];
+        m_speed[index] = m_speed[last];
+        m_fps[index] = m_fps[last];
+        m_frameCount[index] = m_frameCount[last];
+        m_invFrameCount[index] = m_invFrameCount[last];
+        m_duration[index] = m_duration[last];
+        m_loop[index] = m_loop[last];
+        m_frame[index] = m_frame[last];
+        m_finished[index] = m_finished[last];
+        m_clip[index] = m_clip[last];
+        m_posX[index] = m_posX[last];
+        m_posY[index] = m_posY[last];
+        m_sizeX[index] = m_sizeX[last];
+        m_sizeY[index] = m_sizeY[last];
+        m_color[index] = m_color[last];
+
+        AnimationID moved = m_indexToHandle[last];
+        m_indexToHandle[index] = moved;
+        m_handleToIndex[moved] = index;
+    }
+
+    m_time.pop_back();
+    m_speed.pop_back();
+    m_fps.pop_back();
+    m_frameCount.pop_back();
+    m_invFrameCount.pop_back();
+    m_duration.pop_back();
+    m_loop.pop_back();
+    m_frame.pop_back();
+    m_finished.pop_back();
+    m_clip.pop_back();
+    m_posX.pop_back();
+    m_posY.pop_back();
+    m_sizeX.pop_back();
+    m_sizeY.pop_back();
+    m_color.pop_back();
+    m_indexToHandle.pop_back();
+
+    m_handleToIndex[removed] = InvalidIndex;
+    m_freeHandles.push_back(removed);
+}
+
+void AnimationSystem::Stop(AnimationID id) {
+    if (!IsPlaying(id)) {
+        return;
+    }
+    RemoveAt(m_handleToIndex[id]);
+}
+
+bool AnimationSystem::IsPlaying(AnimationID id) const {
+    return id < m_handleToIndex.size() && m_handleToIndex[id] != InvalidIndex;
+}
+
+void AnimationSystem::SetPosition(AnimationID id, const Math::Vector2f& pos) {
+    if (!IsPlaying(id)) {
+        throw Core::Exception("AnimationSystem::SetPosition: animation is not playing");
+    }
+    uint32_t index = m_handleToIndex[id];
+    m_posX[index] = pos.x;
+    m_posY[index] = pos.y;
+}
+
+void AnimationSystem::Clear() {
+    while (!m_time.empty()) {
+        RemoveAt(static_cast<uint32_t>(m_time.size() - 1));
+    }
+}
+
+/* ============================================================== */
+/* Playback                                                       */
+/* ============================================================== */
+void AnimationSystem::Update(float deltaTime) {
+    using Math::Simd::Float4;
+
+    size_t count = m_time.size();
+    size_t i = 0;
+
+    const Float4 dt(deltaTime);
+    const Float4 zero(0.0f);
+    const Float4 one(1.0f);
+    bool anyFinished = false;
+
+    for (; i + 4 <= count; i += 4) {
+        Float4 time = Float4::Load(&m_time[i]) + dt * Float4::Load(&m_speed[i]);
+        Float4 frames = Float4::Load(&m_frameCount[i]);
+        Float4 loop = zero < Float4::Load(&m_loop[i]);
+
+        Float4 frame = time * Float4::Load(&m_fps[i]);
+        Float4 cycles = Float4::Truncate(frame * Float4::Load(&m_invFrameCount[i]));
+        Float4 finished = Float4::Select(loop, zero, frames <= frame);
+
+        // Looping clips wrap both the frame and the clock; one-shots clamp on the last frame
+        Float4 wrapped = frame - cycles * frames;
+        time = Float4::Select(loop, time - cycles * Float4::Load(&m_duration[i]), time);
+        frame = Float4::Min(Float4::Select(loop, wrapped, frame), frames - one);
+
+        time.Store(&m_time[i]);
+        frame.StoreInt(&m_frame[i]);
+
+        int mask = finished.Mask();
+        if (mask != 0) {
+            anyFinished = true;
+            for (int k = 0; k < 4; ++k) {
+                m_finished[i + k] = static_cast<uint8_t>((mask >> k) & 1);
+            }
+        }
+    }
+
+    for (; i < count; ++i) {
+        float time = m_time[i] + deltaTime * m_speed[i];
+        float frame = time * m_fps[i];
+        if (m_loop[i] > 0.0f) {
+            float cycles = static_cast<float>(static_cast<int32_t>(frame * m_invFrameCount[i]));
+            frame -= cycles * m_frameCount[i];
+            time -= cycles * m_duration[i];
+        }
+        else if (frame >= m_frameCount[i]) {
+            m_finished[i] = 1;
+            anyFinished = true;
+        }
+        m_time[i] = time;
+        m_frame[i] = static_cast<int32_t>(std::min(frame, m_frameCount[i] - 1.0f));
+    }
+
+    if (anyFinished) {
+        // Walk backwards so swap-removal never skips an unvisited instance
+        for (size_t j = count; j-- > 0;) {
+            if (m_finished[j]) {
+                RemoveAt(static_cast<uint32_t>(j));
+            }
+        }
+    }
+}
+
+void AnimationSystem::Emit(SpriteBatch& batch) const {
+    size_t count = m_time.size();
+    size_t i = 0;
+
+    while (i < count) {
+        // Reserve one run per texture so the batch keeps a single range for it
+        GLuint texture = m_clips[m_clip[i]].texture;
+        size_t end = i + 1;
+        while (end < count && m_clips[m_clip[end]].texture == texture) {
+            ++end;
+        }
+
+        SpriteVertex* out = batch.Reserve(texture, end - i);
+        for (; i < end; ++i, out += 4) {
+            const UVRect& uv = m_frameUVs[m_clips[m_clip[i]].firstUV + static_cast<uint32_t>(m_frame[i])];
+            float hx = m_sizeX[i] * 0.5f;
+            float hy = m_sizeY[i] * 0.5f;
+            SpriteBatch::WriteQuad(out, m_posX[i] - hx, m_posY[i] - hy, m_posX[i] + hx, m_posY[i] + hy, uv, m_color[i]);
+        }
+    }
+}
+
+size_t AnimationSystem::GetInstanceCount() const {
+    return m_time.size();
+}
@@ -0,0 +1,308 @@
+#include <Renderer/CommandList.hpp>
+#include <Renderer/Draw.hpp>
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+using namespace Renderer;
+
+namespace {
+    // Key layout, most significant first:
+    //   opaque:      layer:8 | 0:1 | shader:8 | texture:24 | depth:23
+    //   translucent: layer:8 | 1:1 | 0:32                 | depth:23
+    // Translucent keys leave out shader and texture: the sort is stable, so
+    // equal depths fall back to record order and overlaps blend as drawn.
+    constexpr int LayerShift = 56;
+    constexpr int TranslucentShift = 55;
+    constexpr uint64_t DepthMask = (1ull << 23) - 1;
+    constexpr uint64_t ShaderMask = 0xFF;
+    constexpr uint64_t TextureMask = (1ull << 24) - 1;
+
+    // SortKeys: packed bit runs, and the widest digit a pass takes
+    constexpr int MaxRuns = 4;
+    constexpr int MaxDigitBits = 11;
+}
+
+// LSD radix sort over the key bits that vary in this frame. Only a few fields
+// do (layer, a depth range, a few dozen textures), so those bits are first
+// packed into a 32-bit digit word, which usually leaves two passes. The passes
+// move 4-byte indices, never the keys or the commands.
+void CommandList::SortKeys(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, SortScratch& scratch) {
+    size_t count = keys.size();
+    order.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = static_cast<uint32_t>(i);
+    }
+
+    uint64_t allAnd = ~0ull;
+    uint64_t allOr = 0;
+    for (uint64_t key : keys) {
+        allAnd &= key;
+        allOr |= key;
+    }
+    uint64_t varying = allAnd ^ allOr;
+    if (count < 2 || varying == 0) {
+        return;
+    }
+
+    // Runs of varying bits, the closest ones merged until four remain
+    int shifts[64];
+    int widths[64];
+    int runCount = 0;
+    while (varying != 0) {
+        int shift = std::countr_zero(varying);
+        int width = std::countr_one(varying >> shift);
+        shifts[runCount] = shift;
+        widths[runCount] = width;
+        ++runCount;
+        varying = shift + width >= 64 ? 0 : varying & (~0ull << (shift + width));
+    }
+    while (runCount > MaxRuns) {
+        int merge = 1;
+        for (int run = 2; run < runCount; ++run) {
+            if (shifts[run] - shifts[run - 1] - widths[run - 1] < shifts[merge] - shifts[merge - 1] - widths[merge - 1]) {
+                merge = run;
+            }
+        }
+        widths[merge - 1] = shifts[merge] + widths[merge] - shifts[merge - 1];
+        for (int run = merge; run + 1 < runCount; ++run) {
+            shifts[run] = shifts[run + 1];
+            widths[run] = widths[run + 1];
+        }
+        --runCount;
+    }
+
+    int bits = 0;
+    for (int run = 0; run < runCount; ++run) {
+        bits += widths[run];
+    }
+    if (bits > 32) {
+        // Nearly every field differs; rare enough for a comparison sort
+        std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+        return;
+    }
+
+    // Unused runs get an empty mask so packing stays branch free
+    int runShifts[MaxRuns] = {};
+    int runOffsets[MaxRuns] = {};
+    uint64_t runMasks[MaxRuns] = {};
+    for (int run = 0, offset = 0; run < runCount; offset += widths[run], ++run) {
+        runShifts[run] = shifts[run];
+        runOffsets[run] = offset;
+        runMasks[run] = (1ull << widths[run]) - 1;
+    }
+    std::vector<uint32_t>& digits = scratch.digits;
+    digits.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = keys[i];
+        uint64_t packed = 0;
+        for (int run = 0; run < MaxRuns; ++run) {
+            packed |= ((key >> runShifts[run]) & runMasks[run]) << runOffsets[run];
+        }
+        digits[i] = static_cast<uint32_t>(packed);
+    }
+
+    int passCount = (bits + MaxDigitBits - 1) / MaxDigitBits;
+    int digitBits = (bits + passCount - 1) / passCount;
+    uint32_t digitMask = (1u << digitBits) - 1;
+
+    std::vector<uint32_t>& other = scratch.indices;
+    other.resize(count);
+    // Ping-pong so the last pass lands in 'order'
+    uint32_t* src = order.data();
+    uint32_t* dst = passCount % 2 == 0 ? other.data() : order.data();
+    if (dst == src) {
+        std::copy(order.begin(), order.end(), other.begin());
+        src = other.data();
+    }
+    for (int pass = 0; pass < passCount; ++pass) {
+        int shift = pass * digitBits;
+
+        // Two sets of counters, so runs of equal digits don't serialize on one
+        uint32_t histogram[2][1u << MaxDigitBits] = {};
+        size_t i = 0;
+        for (; i + 1 < count; i += 2) {
+            ++histogram[0][(digits[i] >> shift) & digitMask];
+            ++histogram[1][(digits[i + 1] >> shift) & digitMask];
+        }
+        if (i < count) {
+            ++histogram[0][(digits[i] >> shift) & digitMask];
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket <= digitMask; ++bucket) {
+            uint32_t bucketCount = histogram[0][bucket] + histogram[1][bucket];
+            histogram[0][bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t j = 0; j < count; ++j) {
+            uint32_t index = src[j];
+            dst[histogram[0][(digits[index] >> shift) & digitMask]++] = index;
+        }
+        std::swap(src, dst);
+    }
+}
+
+CommandList::CommandList(size_t reserveSprites) {
+    m_vertices.reserve(reserveSprites * 4);
+    m_commands.reserve(64);
+    m_keys.reserve(64);
+}
+
+void CommandList::Reset() {
+    m_commands.clear();
+    m_keys.clear();
+    m_vertices.clear();
+    m_clearColors.clear();
+    m_calls.clear();
+    m_spans.clear();
+    m_isSorted = true;
+}
+
+void CommandList::Push(const Command& command, uint64_t key) {
+    m_commands.push_back(command);
+    m_keys.push_back(key);
+    m_isSorted = false;
+}
+
+uint64_t CommandList::MakeSortKey(const DrawParams& params, GLuint texture) {
+    uint64_t layer = params.layer;
+    uint64_t depth = std::min<uint64_t>(params.depth, DepthMask);
+    uint64_t shader = params.shader ? (params.shader->GetProgram() & ShaderMask) : 0;
+    uint64_t tex = texture & TextureMask;
+
+    if (!params.translucent) {
+        return (layer << LayerShift) | (shader << 47) | (tex << 23) | depth;
+    }
+    return (layer << LayerShift) | (1ull << TranslucentShift) | depth;
+}
+
+/* ============================================================== */
+/* Recording                                                      */
+/* ============================================================== */
+void CommandList::Clear(const Math::Vector4f& color) {
+    Command command{};
+    command.type = CommandType::Clear;
+    command.clearIndex = static_cast<uint32_t>(m_clearColors.size());
+    m_clearColors.push_back(color);
+    Push(command, 0);
+}
+
+void CommandList::TexturedQuad(GLuint textureID, const Math::Vector2f& size, const Math::Vector2f& pos, const DrawParams& params) {
+    if (textureID == 0 || size.x <= 0 || size.y <= 0) {
+        return;
+    }
+
+    uint32_t first = static_cast<uint32_t>(m_vertices.size());
+    m_vertices.resize(m_vertices.size() + 4);
+    float hx = size.x * 0.5f;
+    float hy = size.y * 0.5f;
+    SpriteBatch::WriteQuad(&m_vertices[first], pos.x - hx, pos.y - hy, pos.x + hx, pos.y + hy, UVRect{}, SpriteBatch::White);
+
+    Command command{};
+    command.type = CommandType::Sprites;
+    command.translucent = params.translucent;
+    command.range = SpriteBatch::Range{ textureID, first, 4 };
+    command.shader = params.shader;
+    Push(command, MakeSortKey(params, textureID));
+}
+
+void CommandList::Sprites(const SpriteBatch& batch, const DrawParams& params) {
+    const std::vector<SpriteVertex>& vertices = batch.GetVertices();
+    if (vertices.empty()) {
+        return;
+    }
+
+    uint32_t base = static_cast<uint32_t>(m_vertices.size());
+    m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+    for (const SpriteBatch::Range& range : batch.GetRanges()) {
+        Command command{};
+        command.type = CommandType::Sprites;
+        command.translucent = params.translucent;
+        command.range = SpriteBatch::Range{ range.texture, base + range.firstVertex, range.vertexCount };
+        command.shader = params.shader;
+        Push(command, MakeSortKey(params, range.texture));
+    }
+}
+
+/* ============================================================== */
+/* Sorting and replay                                             */
+/* ============================================================== */
+void CommandList::Sort() {
+    if (m_isSorted) {
+        return;
+    }
+
+    SortKeys(m_keys, m_order, m_sortScratch);
+
+    // Neighbours with the same state become one call over several spans
+    m_calls.clear();
+    m_spans.clear();
+    for (uint32_t index : m_order) {
+        const Command& command = m_commands[index];
+        if (command.type != CommandType::Sprites) {
+            m_calls.push_back(Call{ 0, nullptr, command.clearIndex, 0, 0, command.type, false });
+            continue;
+        }
+
+        Call* last = m_calls.empty() ? nullptr : &m_calls.back();
+        if (!last || last->type != CommandType::Sprites || last->texture != command.range.texture ||
+            last->shader != command.shader || last->translucent != command.translucent) {
+            m_calls.push_back(Call{ command.range.texture, command.shader, 0, static_cast<uint32_t>(m_spans.size()), 0,
+                CommandType::Sprites, command.translucent });
+            last = &m_calls.back();
+        }
+        else {
+            SpriteBatch::Range& span = m_spans.back();
+            if (span.firstVertex + span.vertexCount == command.range.firstVertex) {
+                span.vertexCount += command.range.vertexCount;
+                continue;
+            }
+        }
+        m_spans.push_back(command.range);
+        ++last->spanCount;
+    }
+    m_isSorted = true;
+}
+
+void CommandList::Execute() {
+    Sort();
+
+    // Every draw shares one upload of the vertices as recorded
+    Draw::UploadVertices(m_vertices.data(), m_vertices.size());
+
+    for (const Call& call : m_calls) {
+        switch (call.type) {
+        case CommandType::Clear:
+            Draw::Clear(m_clearColors[call.clearIndex]);
+            break;
+        case CommandType::Sprites:
+            Draw::DrawRanges(m_spans.data() + call.firstSpan, call.spanCount, call.shader, call.translucent);
+            break;
+        }
+    }
+}
+
+const std::vector<CommandList::Command>& CommandList::GetCommands() const {
+    return m_commands;
+}
+
+const std::vector<CommandList::Call>& CommandList::GetCalls() const {
+    return m_calls;
+}
+
+const std::vector<SpriteBatch::Range>& CommandList::GetSpans() const {
+    return m_spans;
+}
+
+size_t CommandList::GetDrawCallCount() const {
+    size_t draws = 0;
+    for (const Call& call : m_calls) {
+        draws += call.type == CommandType::Sprites ? 1 : 0;
+    }
+    return draws;
+}
+
+bool CommandList::IsEmpty() const {
+    return m_commands.empty();
+}
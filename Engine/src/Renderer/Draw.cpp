@@ -1,48 +1,229 @@
 #include <Renderer/Draw.hpp>
+#include <Renderer/GL.hpp>
+#include <Renderer/StateCache.hpp>
+#include <Util/Log.hpp>
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_opengl.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
 
 static int g_screenWidth = 800;
 static int g_screenHeight = 600;
 
+static std::unique_ptr<Renderer::ShaderLibrary> g_shaders;
+static Renderer::Shader* g_spriteShader = nullptr;
+static GLuint g_vao = 0;
+static GLuint g_vbo = 0;
+static GLuint g_ibo = 0;
+static GLuint g_cameraUbo = 0;
+static size_t g_vboCapacity = 0;   // bytes
+static size_t g_iboCapacity = 0;   // sprites
+static Renderer::SpriteBatch g_immediate(1);
+static std::vector<GLsizei> g_multiCounts;
+static std::vector<const void*> g_multiOffsets;
+static Util::Logger g_logger("Draw");
+
+namespace {
+    // Column-major orthographic projection with a top-left origin
+    void Ortho(float* m, float left, float right, float bottom, float top, float zNear, float zFar) {
+        for (int i = 0; i < 16; ++i) m[i] = 0.0f;
+        m[0] = 2.0f / (right - left);
+        m[5] = 2.0f / (top - bottom);
+        m[10] = -2.0f / (zFar - zNear);
+        m[12] = -(right + left) / (right - left);
+        m[13] = -(top + bottom) / (top - bottom);
+        m[14] = -(zFar + zNear) / (zFar - zNear);
+        m[15] = 1.0f;
+    }
+
+    void EnsureIndexCapacity(size_t sprites) {
+        if (sprites <= g_iboCapacity) {
+            return;
+        }
+
+        size_t capacity = g_iboCapacity == 0 ? 4096 : g_iboCapacity;
+        while (capacity < sprites) {
+            capacity *= 2;
+        }
+
+        // Two triangles per quad: 0-1-2, 2-3-0
+        std::vector<GLuint> indices(capacity * 6);
+        for (size_t i = 0; i < capacity; ++i) {
+            GLuint base = static_cast<GLuint>(i * 4);
+            GLuint* out = &indices[i * 6];
+            out[0] = base + 0; out[1] = base + 1; out[2] = base + 2;
+            out[3] = base + 2; out[4] = base + 3; out[5] = base + 0;
+        }
+
+        Renderer::StateCache& state = Renderer::StateCache::Get();
+        state.BindVertexArray(g_vao);
+        state.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ibo);
+        Renderer::GL::BufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+        g_iboCapacity = capacity;
+    }
+}
+
 void Renderer::Draw::Init(const Math::Vector2f& screenSize, bool vsync) {
+    if (!GL::IsLoaded()) {
+        throw Core::Exception("Draw::Init: OpenGL functions are not loaded");
+    }
+
     g_screenWidth = static_cast<int>(screenSize.x);
     g_screenHeight = static_cast<int>(screenSize.y);
 
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(0, g_screenWidth, g_screenHeight, 0, -1, 1); // Top-left origin
+    g_shaders = std::make_unique<ShaderLibrary>();
+    g_shaders->LoadBuiltins();
+    g_spriteShader = g_shaders->Get("sprite");
+
+    StateCache& state = StateCache::Get();
+    state.Invalidate();
+    state.UseProgram(g_spriteShader->GetProgram());
+    GL::Uniform1i(g_spriteShader->GetUniformLocation("u_texture"), 0);
+
+    // Projection lives in a uniform buffer shared by every shader
+    float projection[16];
+    Ortho(projection, 0.0f, static_cast<float>(g_screenWidth), static_cast<float>(g_screenHeight), 0.0f, -1.0f, 1.0f);
+    GL::GenBuffers(1, &g_cameraUbo);
+    state.BindBuffer(GL_UNIFORM_BUFFER, g_cameraUbo);
+    GL::BufferData(GL_UNIFORM_BUFFER, sizeof(projection), projection, GL_STATIC_DRAW);
+    GL::BindBufferBase(GL_UNIFORM_BUFFER, ShaderLibrary::CameraBinding, g_cameraUbo);
 
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    GL::GenVertexArrays(1, &g_vao);
+    GL::GenBuffers(1, &g_vbo);
+    GL::GenBuffers(1, &g_ibo);
 
-    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+    state.BindVertexArray(g_vao);
+    state.BindBuffer(GL_ARRAY_BUFFER, g_vbo);
+    GL::EnableVertexAttribArray(0);
+    GL::VertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), reinterpret_cast<const void*>(offsetof(SpriteVertex, x)));
+    GL::EnableVertexAttribArray(1);
+    GL::VertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), reinterpret_cast<const void*>(offsetof(SpriteVertex, u)));
+    GL::EnableVertexAttribArray(2);
+    GL::VertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteVertex), reinterpret_cast<const void*>(offsetof(SpriteVertex, color)));
+    EnsureIndexCapacity(4096);
+
+    glViewport(0, 0, g_screenWidth, g_screenHeight);
+    state.ClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+    state.Enable(GL_BLEND);
+    state.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     SDL_GL_SetSwapInterval(vsync ? 1 : 0);
 }
 
+void Renderer::Draw::Shutdown() {
+    if (!g_shaders) {
+        return;
+    }
+    StateCache& state = StateCache::Get();
+    if (g_vao != 0) {
+        GL::DeleteVertexArrays(1, &g_vao);
+        state.OnVertexArrayDeleted(g_vao);
+        g_vao = 0;
+    }
+    GLuint buffers[] = { g_vbo, g_ibo, g_cameraUbo };
+    GL::DeleteBuffers(3, buffers);
+    for (GLuint buffer : buffers) {
+        state.OnBufferDeleted(buffer);
+    }
+    g_vbo = g_ibo = g_cameraUbo = 0;
+    g_vboCapacity = 0;
+    g_iboCapacity = 0;
+
+    g_spriteShader = nullptr;
+    g_shaders.reset();
+    state.Invalidate();
+}
+
+Renderer::ShaderLibrary& Renderer::Draw::GetShaderLibrary() {
+    if (!g_shaders) {
+        throw Core::Exception("Draw::GetShaderLibrary: Draw::Init has not been called");
+    }
+    return *g_shaders;
+}
+
 void Renderer::Draw::Clear(Math::Vector4f color) {
-    glClearColor(color.x, color.y, color.z, color.w);
+    StateCache::Get().ClearColor(color.x, color.y, color.z, color.w);
     glClear(GL_COLOR_BUFFER_BIT);
 }
 
 void Renderer::Draw::TexturedQuad(GLuint textureID, const Math::Vector2f& size, const Math::Vector2f& pos) {
     if (textureID == 0 || size.x <= 0 || size.y <= 0) {
-        SDL_Log("Draw::TexturedQuad: Invalid parameters (textureID=%u, size=%.2fx%.2f)", textureID, size.x, size.y);
+        // Rate limited per call site, a bad sprite drawn every frame can't flood the console
+        g_logger.Warn("TexturedQuad: invalid parameters (textureID={}, size={:.2f}x{:.2f})", textureID, size.x, size.y);
         return;
     }
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    g_immediate.Clear();
+    g_immediate.Draw(textureID, pos, size);
+    Batch(g_immediate);
+}
 
-    Math::Vector2f half = size * 0.5f;
+void Renderer::Draw::Batch(const SpriteBatch& batch) {
+    const std::vector<SpriteVertex>& vertices = batch.GetVertices();
+    if (vertices.empty()) {
+        return;
+    }
+
+    UploadVertices(vertices.data(), vertices.size());
+    for (const SpriteBatch::Range& range : batch.GetRanges()) {
+        DrawRange(range);
+    }
+}
+
+void Renderer::Draw::UploadVertices(const SpriteVertex* vertices, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    EnsureIndexCapacity(count / 4);
+
+    StateCache& state = StateCache::Get();
+    state.BindVertexArray(g_vao);
+
+    // Orphan the previous storage so the driver never waits on in-flight draws
+    size_t bytes = count * sizeof(SpriteVertex);
+    if (bytes > g_vboCapacity) {
+        g_vboCapacity = bytes * 2;
+    }
+    state.BindBuffer(GL_ARRAY_BUFFER, g_vbo);
+    GL::BufferData(GL_ARRAY_BUFFER, g_vboCapacity, nullptr, GL_STREAM_DRAW);
+    GL::BufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices);
+}
+
+void Renderer::Draw::DrawRange(const SpriteBatch::Range& range, const Shader* shader, bool blend) {
+    DrawRanges(&range, 1, shader, blend);
+}
+
+void Renderer::Draw::DrawRanges(const SpriteBatch::Range* ranges, size_t count, const Shader* shader, bool blend) {
+    if (count == 0) {
+        return;
+    }
 
-    // Quad centered at 'pos'
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 1.0f); glVertex2f(pos.x - half.x, pos.y - half.y); // bottom-left
-    glTexCoord2f(1.0f, 1.0f); glVertex2f(pos.x + half.x, pos.y - half.y); // bottom-right
-    glTexCoord2f(1.0f, 0.0f); glVertex2f(pos.x + half.x, pos.y + half.y); // top-right
-    glTexCoord2f(0.0f, 0.0f); glVertex2f(pos.x - half.x, pos.y + half.y); // top-left
-    glEnd();
+    StateCache& state = StateCache::Get();
+    if (blend) {
+        state.Enable(GL_BLEND);
+        state.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else {
+        state.Disable(GL_BLEND);
+    }
+    state.UseProgram(shader ? shader->GetProgram() : g_spriteShader->GetProgram());
+    state.BindVertexArray(g_vao);
+    state.BindTexture(GL_TEXTURE0, ranges[0].texture);
+
+    if (count == 1) {
+        size_t firstIndex = static_cast<size_t>(ranges[0].firstVertex / 4) * 6;
+        GLsizei indexCount = static_cast<GLsizei>(ranges[0].vertexCount / 4 * 6);
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, reinterpret_cast<const void*>(firstIndex * sizeof(GLuint)));
+        return;
+    }
 
-    glDisable(GL_TEXTURE_2D);
+    g_multiCounts.resize(count);
+    g_multiOffsets.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t firstIndex = static_cast<size_t>(ranges[i].firstVertex / 4) * 6;
+        g_multiCounts[i] = static_cast<GLsizei>(ranges[i].vertexCount / 4 * 6);
+        g_multiOffsets[i] = reinterpret_cast<const void*>(firstIndex * sizeof(GLuint));
+    }
+    GL::MultiDrawElements(GL_TRIANGLES, g_multiCounts.data(), GL_UNSIGNED_INT, g_multiOffsets.data(), static_cast<GLsizei>(count));
 }
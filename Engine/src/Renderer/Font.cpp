@@ -0,0 +1,196 @@
+#include <Renderer/Font.hpp>
+#include <Core/Exceptions.hpp>
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <charconv>
+
+// ImGui compiles its own static copy in imgui_draw.cpp, so ours stays static too
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <imstb_truetype.h>
+
+using namespace Renderer;
+
+Font::Font(TextureManager& textures, const std::string& name, const std::string& ttfPath, float pixelHeight)
+    : m_logger("Font"), m_pixelHeight(pixelHeight) {
+    size_t dataSize = 0;
+    unsigned char* data = static_cast<unsigned char*>(SDL_LoadFile(ttfPath.c_str(), &dataSize));
+    if (!data) {
+        std::string errorMsg = "Failed to load font '" + ttfPath + "': " + SDL_GetError();
+        m_logger.Error("{}", errorMsg);
+        throw Core::Exception(errorMsg);
+    }
+
+    stbtt_fontinfo info;
+    if (!stbtt_InitFont(&info, data, stbtt_GetFontOffsetForIndex(data, 0))) {
+        SDL_free(data);
+        std::string errorMsg = "Failed to parse font '" + ttfPath + "'";
+        m_logger.Error("{}", errorMsg);
+        throw Core::Exception(errorMsg);
+    }
+
+    int ascent = 0, descent = 0, lineGap = 0;
+    stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
+    float scale = stbtt_ScaleForPixelHeight(&info, pixelHeight);
+    m_ascent = static_cast<float>(ascent) * scale;
+    m_lineHeight = static_cast<float>(ascent - descent + lineGap) * scale;
+
+    // Grow the atlas until every glyph fits
+    stbtt_bakedchar baked[CharCount];
+    std::vector<unsigned char> coverage;
+    int atlasSize = 256;
+    for (;; atlasSize *= 2) {
+        if (atlasSize > 4096) {
+            SDL_free(data);
+            std::string errorMsg = "Font '" + ttfPath + "' does not fit in a 4096x4096 atlas";
+            m_logger.Error("{}", errorMsg);
+            throw Core::Exception(errorMsg);
+        }
+        coverage.assign(static_cast<size_t>(atlasSize) * atlasSize, 0);
+        if (stbtt_BakeFontBitmap(data, 0, pixelHeight, coverage.data(), atlasSize, atlasSize, FirstChar, CharCount, baked) > 0) {
+            break;
+        }
+    }
+    SDL_free(data);
+
+    // White glyphs with coverage in alpha, so the sprite color tints them
+    std::vector<uint32_t> pixels(coverage.size());
+    for (size_t i = 0; i < coverage.size(); ++i) {
+        pixels[i] = 0x00FFFFFFu | (static_cast<uint32_t>(coverage[i]) << 24);
+    }
+    TextureData* atlas = textures.AddTextureFromPixels(name, pixels.data(), atlasSize, atlasSize);
+    m_texture = atlas->id;
+
+    float inv = 1.0f / static_cast<float>(atlasSize);
+    for (int i = 0; i < CharCount; ++i) {
+        const stbtt_bakedchar& bc = baked[i];
+        Glyph& g = m_glyphs[i];
+        g.uv = UVRect{ bc.x0 * inv, bc.y0 * inv, bc.x1 * inv, bc.y1 * inv };
+        g.x0 = bc.xoff;
+        g.y0 = bc.yoff;
+        g.x1 = bc.xoff + static_cast<float>(bc.x1 - bc.x0);
+        g.y1 = bc.yoff + static_cast<float>(bc.y1 - bc.y0);
+        g.advance = bc.xadvance;
+    }
+
+    m_logger.Info("Baked font '{}' from '{}' at {}px into a {}x{} atlas", name, ttfPath, pixelHeight, atlasSize, atlasSize);
+}
+
+const Font::Glyph& Font::GetGlyph(char c) const {
+    int index = static_cast<unsigned char>(c) - FirstChar;
+    if (index < 0 || index >= CharCount) {
+        index = '?' - FirstChar;
+    }
+    return m_glyphs[index];
+}
+
+const Font::TextRun& Font::Shape(std::string_view text) {
+    auto it = m_runIndex.find(text);
+    if (it != m_runIndex.end()) {
+        m_runs.splice(m_runs.begin(), m_runs, it->second);
+        return it->second->second;
+    }
+
+    TextRun run;
+    run.quads.reserve(text.size());
+    float penX = 0.0f;
+    float baseline = m_ascent;
+    for (char c : text) {
+        if (c == '\n') {
+            penX = 0.0f;
+            baseline += m_lineHeight;
+            continue;
+        }
+        const Glyph& g = GetGlyph(c);
+        if (g.x1 > g.x0) {
+            run.quads.push_back(GlyphQuad{ penX + g.x0, baseline + g.y0, penX + g.x1, baseline + g.y1, g.uv });
+        }
+        penX += g.advance;
+        run.width = std::max(run.width, penX);
+    }
+
+    while (m_runs.size() >= m_runCapacity) {
+        m_runIndex.erase(m_runs.back().first);
+        m_runs.pop_back();
+    }
+    m_runs.emplace_front(std::string(text), std::move(run));
+    m_runIndex.emplace(m_runs.front().first, m_runs.begin());
+    return m_runs.front().second;
+}
+
+void Font::Draw(SpriteBatch& batch, std::string_view text, const Math::Vector2f& pos, uint32_t color) {
+    const TextRun& run = Shape(text);
+    if (run.quads.empty()) {
+        return;
+    }
+
+    SpriteVertex* out = batch.Reserve(m_texture, run.quads.size());
+    for (const GlyphQuad& q : run.quads) {
+        SpriteBatch::WriteQuad(out, pos.x + q.x0, pos.y + q.y0, pos.x + q.x1, pos.y + q.y1, q.uv, color);
+        out += 4;
+    }
+}
+
+void Font::EmitGlyphs(SpriteBatch& batch, std::string_view text, const Math::Vector2f& pos, uint32_t color) const {
+    SpriteVertex* out = batch.Reserve(m_texture, text.size());
+    size_t written = 0;
+    float penX = pos.x;
+    float baseline = pos.y + m_ascent;
+    for (char c : text) {
+        const Glyph& g = GetGlyph(c);
+        if (g.x1 > g.x0) {
+            SpriteBatch::WriteQuad(out, penX + g.x0, baseline + g.y0, penX + g.x1, baseline + g.y1, g.uv, color);
+            out += 4;
+            ++written;
+        }
+        penX += g.advance;
+    }
+
+    // Blank glyphs (e.g. spaces) were reserved but not written
+    for (; written < text.size(); ++written, out += 4) {
+        SpriteBatch::WriteQuad(out, 0.0f, 0.0f, 0.0f, 0.0f, UVRect{}, 0);
+    }
+}
+
+void Font::DrawNumber(SpriteBatch& batch, int64_t value, const Math::Vector2f& pos, uint32_t color) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    EmitGlyphs(batch, std::string_view(buffer, result.ptr - buffer), pos, color);
+}
+
+float Font::Measure(std::string_view text) {
+    return Shape(text).width;
+}
+
+float Font::GetLineHeight() const {
+    return m_lineHeight;
+}
+
+float Font::GetPixelHeight() const {
+    return m_pixelHeight;
+}
+
+GLuint Font::GetTexture() const {
+    return m_texture;
+}
+
+size_t Font::GetCachedRunCount() const {
+    return m_runs.size();
+}
+
+void Font::SetRunCapacity(size_t runs) {
+    m_runCapacity = std::max<size_t>(runs, 1);
+    while (m_runs.size() > m_runCapacity) {
+        m_runIndex.erase(m_runs.back().first);
+        m_runs.pop_back();
+    }
+}
+
+size_t Font::GetRunCapacity() const {
+    return m_runCapacity;
+}
+
+void Font::ClearCache() {
+    m_runIndex.clear();
+    m_runs.clear();
+}
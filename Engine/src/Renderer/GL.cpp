@@ -0,0 +1,65 @@
+#include <Renderer/GL.hpp>
+#include <Util/Log.hpp>
+#include <SDL3/SDL.h>
+
+namespace Renderer {
+    namespace GL {
+#define RENDERER_GL_DEFINE(type, name) type name = nullptr;
+        RENDERER_GL_FUNCTIONS(RENDERER_GL_DEFINE)
+        RENDERER_GL_OPTIONAL_FUNCTIONS(RENDERER_GL_DEFINE)
+#undef RENDERER_GL_DEFINE
+
+        static bool s_loaded = false;
+        static bool s_bufferStorage = false;
+
+        bool Load() {
+            Util::Logger logger("GL");
+            bool ok = true;
+
+#define RENDERER_GL_LOAD(type, name) \
+            name = reinterpret_cast<type>(SDL_GL_GetProcAddress("gl" #name)); \
+            if (!name) { \
+                logger.Error("Missing OpenGL function gl{}", #name); \
+                ok = false; \
+            }
+            RENDERER_GL_FUNCTIONS(RENDERER_GL_LOAD)
+#undef RENDERER_GL_LOAD
+
+#define RENDERER_GL_LOAD_OPTIONAL(type, name) \
+            name = reinterpret_cast<type>(SDL_GL_GetProcAddress("gl" #name));
+            RENDERER_GL_OPTIONAL_FUNCTIONS(RENDERER_GL_LOAD_OPTIONAL)
+#undef RENDERER_GL_LOAD_OPTIONAL
+
+            s_loaded = ok;
+            if (ok) {
+                // A non-null proc address alone doesn't mean the driver supports it
+                s_bufferStorage = BufferStorage != nullptr && HasExtension("GL_ARB_buffer_storage");
+                logger.Info("OpenGL {} ({}), buffer storage: {}",
+                    reinterpret_cast<const char*>(glGetString(GL_VERSION)),
+                    reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+                    s_bufferStorage ? "yes" : "no");
+            }
+            return ok;
+        }
+
+        bool HasExtension(const char* name) {
+            GLint count = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+            for (GLint i = 0; i < count; ++i) {
+                const char* extension = reinterpret_cast<const char*>(GetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+                if (extension && SDL_strcmp(extension, name) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool HasBufferStorage() {
+            return s_bufferStorage;
+        }
+
+        bool IsLoaded() {
+            return s_loaded;
+        }
+    }
+}
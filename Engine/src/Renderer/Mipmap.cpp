@@ -0,0 +1,85 @@
+#include <Renderer/Mipmap.hpp>
+#include <Math/Simd.hpp>
+#include <algorithm>
+
+using namespace Renderer;
+
+uint32_t Mipmap::LevelCount(uint32_t width, uint32_t height) {
+    uint32_t levels = 1;
+    while ((width >> levels) > 0 || (height >> levels) > 0) {
+        ++levels;
+    }
+    return levels;
+}
+
+size_t Mipmap::LevelBytes(uint32_t width, uint32_t height, uint32_t level) {
+    return static_cast<size_t>(std::max(1u, width >> level)) * std::max(1u, height >> level) * 4;
+}
+
+size_t Mipmap::ChainBytes(uint32_t width, uint32_t height, uint32_t levels) {
+    size_t bytes = 0;
+    for (uint32_t level = 0; level < levels; ++level) {
+        bytes += LevelBytes(width, height, level);
+    }
+    return bytes;
+}
+
+uint32_t Mipmap::FirstLevelWithin(uint32_t width, uint32_t height, uint32_t maxSize) {
+    uint32_t levels = LevelCount(width, height);
+    uint32_t level = 0;
+    while (level + 1 < levels && std::max(std::max(1u, width >> level), std::max(1u, height >> level)) > maxSize) {
+        ++level;
+    }
+    return level;
+}
+
+void Mipmap::Downsample(const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination) {
+    uint32_t dstWidth = std::max(1u, width >> 1);
+    uint32_t dstHeight = std::max(1u, height >> 1);
+    size_t pitch = static_cast<size_t>(width) * 4;
+
+    for (uint32_t y = 0; y < dstHeight; ++y) {
+        const uint8_t* row0 = source + std::min(y * 2, height - 1) * pitch;
+        const uint8_t* row1 = source + std::min(y * 2 + 1, height - 1) * pitch;
+        uint8_t* out = destination + static_cast<size_t>(y) * dstWidth * 4;
+        uint32_t x = 0;
+
+#ifdef MATH_SIMD_SSE2
+        // Two output pixels per step: 4 source pixels from each row widened to
+        // 16 bits, summed vertically, then neighbours summed horizontally
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i round = _mm_set1_epi16(2);
+            for (; x * 2 + 4 <= width; x += 2) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+                __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+                hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+                __m128i sum = _mm_unpacklo_epi64(lo, hi);
+                sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(out + x * 4), _mm_packus_epi16(sum, zero));
+            }
+        }
+#endif
+
+        for (; x < dstWidth; ++x) {
+            uint32_t x0 = std::min(x * 2, width - 1) * 4;
+            uint32_t x1 = std::min(x * 2 + 1, width - 1) * 4;
+            for (int channel = 0; channel < 4; ++channel) {
+                out[x * 4 + channel] = static_cast<uint8_t>(
+                    (row0[x0 + channel] + row0[x1 + channel] + row1[x0 + channel] + row1[x1 + channel] + 2) / 4);
+            }
+        }
+    }
+}
+
+void Mipmap::Build(uint8_t* chain, uint32_t width, uint32_t height, uint32_t levels) {
+    size_t offset = 0;
+    for (uint32_t level = 1; level < levels; ++level) {
+        size_t previous = LevelBytes(width, height, level - 1);
+        Downsample(chain + offset, std::max(1u, width >> (level - 1)), std::max(1u, height >> (level - 1)), chain + offset + previous);
+        offset += previous;
+    }
+}
@@ -0,0 +1,134 @@
+#include <Renderer/Particles.hpp>
+#include <Math/Simd.hpp>
+#include <Core/Exceptions.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace Renderer;
+
+ParticleEmitter::ParticleEmitter(size_t capacity, const EmitterSettings& settings)
+    : m_settings(settings), m_capacity(capacity) {
+    if (capacity == 0) {
+        throw Core::Exception("ParticleEmitter: capacity must be greater than 0");
+    }
+
+    // Padded to a multiple of 4 so Update() never needs a scalar tail
+    size_t padded = (capacity + 3) & ~static_cast<size_t>(3);
+    m_posX.resize(padded);
+    m_posY.resize(padded);
+    m_velX.resize(padded);
+    m_velY.resize(padded);
+    m_life.resize(padded);
+    m_invLifetime.resize(padded);
+    m_alpha.resize(padded);
+}
+
+float ParticleEmitter::NextRandom() {
+    // xorshift32, [0, 1)
+    m_rng ^= m_rng << 13;
+    m_rng ^= m_rng >> 17;
+    m_rng ^= m_rng << 5;
+    return static_cast<float>(m_rng >> 8) * (1.0f / 16777216.0f);
+}
+
+size_t ParticleEmitter::Burst(const Math::Vector2f& pos, size_t count) {
+    size_t spawn = std::min(count, m_capacity - m_count);
+
+    for (size_t n = 0; n < spawn; ++n) {
+        size_t i = m_count++;
+        float angle = m_settings.direction + (NextRandom() - 0.5f) * m_settings.spread;
+        float speed = m_settings.speedMin + (m_settings.speedMax - m_settings.speedMin) * NextRandom();
+        float lifetime = m_settings.lifetime * (1.0f + (NextRandom() * 2.0f - 1.0f) * m_settings.lifetimeVariance);
+        lifetime = std::max(lifetime, 0.001f);
+
+        m_posX[i] = pos.x;
+        m_posY[i] = pos.y;
+        m_velX[i] = std::cos(angle) * speed;
+        m_velY[i] = std::sin(angle) * speed;
+        m_life[i] = lifetime;
+        m_invLifetime[i] = 1.0f / lifetime;
+        m_alpha[i] = 1.0f;
+    }
+    return spawn;
+}
+
+void ParticleEmitter::Update(float deltaTime) {
+    using Math::Simd::Float4;
+
+    const Float4 dt(deltaTime);
+    const Float4 gx(m_settings.gravity.x * deltaTime);
+    const Float4 gy(m_settings.gravity.y * deltaTime);
+    const Float4 damping(std::max(0.0f, 1.0f - m_settings.drag * deltaTime));
+    const Float4 zero(0.0f);
+
+    for (size_t i = 0; i < m_count; i += 4) {
+        Float4 vx = (Float4::Load(&m_velX[i]) + gx) * damping;
+        Float4 vy = (Float4::Load(&m_velY[i]) + gy) * damping;
+        Float4 px = Float4::Load(&m_posX[i]) + vx * dt;
+        Float4 py = Float4::Load(&m_posY[i]) + vy * dt;
+        Float4 life = Float4::Load(&m_life[i]) - dt;
+        Float4 alpha = Float4::Max(life * Float4::Load(&m_invLifetime[i]), zero);
+
+        vx.Store(&m_velX[i]);
+        vy.Store(&m_velY[i]);
+        px.Store(&m_posX[i]);
+        py.Store(&m_posY[i]);
+        life.Store(&m_life[i]);
+        alpha.Store(&m_alpha[i]);
+    }
+
+    // Swap-remove dead particles, keeping the live range dense
+    size_t i = 0;
+    while (i < m_count) {
+        if (m_life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        size_t last = --m_count;
+        m_posX[i] = m_posX[last];
+        m_posY[i] = m_posY[last];
+        m_velX[i] = m_velX[last];
+        m_velY[i] = m_velY[last];
+        m_life[i] = m_life[last];
+        m_invLifetime[i] = m_invLifetime[last];
+        m_alpha[i] = m_alpha[last];
+    }
+}
+
+void ParticleEmitter::Emit(SpriteBatch& batch) const {
+    if (m_count == 0) {
+        return;
+    }
+
+    float hx = m_settings.size.x * 0.5f;
+    float hy = m_settings.size.y * 0.5f;
+    uint32_t rgb = m_settings.color & 0x00FFFFFFu;
+    float baseAlpha = static_cast<float>(m_settings.color >> 24);
+
+    SpriteVertex* out = batch.Reserve(m_settings.texture, m_count);
+    for (size_t i = 0; i < m_count; ++i, out += 4) {
+        uint32_t alpha = static_cast<uint32_t>(baseAlpha * m_alpha[i]);
+        SpriteBatch::WriteQuad(out, m_posX[i] - hx, m_posY[i] - hy, m_posX[i] + hx, m_posY[i] + hy,
+            UVRect{}, rgb | (alpha << 24));
+    }
+}
+
+void ParticleEmitter::Clear() {
+    m_count = 0;
+}
+
+EmitterSettings& ParticleEmitter::GetSettings() {
+    return m_settings;
+}
+
+const EmitterSettings& ParticleEmitter::GetSettings() const {
+    return m_settings;
+}
+
+size_t ParticleEmitter::GetCount() const {
+    return m_count;
+}
+
+size_t ParticleEmitter::GetCapacity() const {
+    return m_capacity;
+}
@@ -0,0 +1,295 @@
+#include <Renderer/RenderThread.hpp>
+#include <Renderer/Renderer.hpp>
+#include <Renderer/StateCache.hpp>
+#include <Core/Exceptions.hpp>
+#include <Core/Latency.hpp>
+#include <SDL3/SDL.h>
+#include <backends/imgui_impl_opengl3.h>
+#include <utility>
+
+using namespace Renderer;
+
+/* ============================================================== */
+/* Frame slots                                                    */
+/* ============================================================== */
+RenderThread::Frame::~Frame() {
+    ReleaseUi();
+}
+
+void RenderThread::Frame::SnapshotUi(ImDrawData* source) {
+    ReleaseUi();
+
+    // ImGui reuses its draw lists next frame, so the render thread gets copies.
+    // Copies are detached from ImGui's shared data and texture references are
+    // resolved to plain IDs, so nothing the game thread mutates is reachable.
+    ui = *source;
+    ui.CmdLists.resize(0);
+    ui.Textures = nullptr;
+    for (ImDrawList* list : source->CmdLists) {
+        ImDrawList* copy = list->CloneOutput();
+        copy->_SetDrawListSharedData(nullptr);
+        for (ImDrawCmd& cmd : copy->CmdBuffer) {
+            cmd.TexRef = ImTextureRef(cmd.GetTexID());
+        }
+        ui.CmdLists.push_back(copy);
+    }
+    hasUi = true;
+}
+
+void RenderThread::Frame::ReleaseUi() {
+    for (ImDrawList* list : ui.CmdLists) {
+        IM_DELETE(list);
+    }
+    ui.CmdLists.resize(0);
+    hasUi = false;
+}
+
+/* ============================================================== */
+/* Lifetime                                                       */
+/* ============================================================== */
+RenderThread::RenderThread(Window& window)
+    : m_window(window), m_logger("RenderThread") {
+}
+
+RenderThread::~RenderThread() {
+    Stop();
+}
+
+void RenderThread::Start() {
+    if (m_running) {
+        return;
+    }
+
+    // A context can only be current on one thread at a time
+    if (!SDL_GL_MakeCurrent(m_window.GetRawWindow(), nullptr)) {
+        throw Core::Exception("RenderThread::Start: failed to release GL context: " + std::string(SDL_GetError()));
+    }
+
+    m_stopRequested = false;
+    m_threadExited = false;
+    m_error = nullptr;
+    m_running = true;
+    m_thread = std::thread(&RenderThread::ThreadMain, this);
+    m_logger.Info("Render thread started");
+}
+
+void RenderThread::Stop() {
+    if (!m_running) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+    m_running = false;
+
+    if (!SDL_GL_MakeCurrent(m_window.GetRawWindow(), m_window.GetGLContext())) {
+        m_logger.Error("Failed to reacquire GL context: {}", SDL_GetError());
+    }
+    StateCache::Get().Invalidate();
+    m_logger.Info("Render thread stopped");
+}
+
+bool RenderThread::IsRunning() const {
+    return m_running;
+}
+
+/* ============================================================== */
+/* Game thread API                                                */
+/* ============================================================== */
+void RenderThread::SetFrameCallback(std::function<void(CommandList&)> callback) {
+    m_frameCallback = std::move(callback);
+}
+
+CommandList& RenderThread::BeginFrame() {
+    CommandList& commands = m_frames[m_writeIndex].commands;
+    commands.Reset();
+    return commands;
+}
+
+void RenderThread::Submit(ImDrawData* ui) {
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+    // Sorting stays on the game thread, the render thread only replays
+    Frame& frame = m_frames[m_writeIndex];
+    frame.commands.Sort();
+    if (ui && ui->Valid) {
+        UpdateUiTextures(ui);
+        frame.SnapshotUi(ui);
+    }
+    else {
+        frame.ReleaseUi();
+    }
+    frame.latencySerial = Core::LatencyTracker::Get().OnSubmitted();
+
+    if (!m_running) {
+        {
+            std::lock_guard lock(m_mutex);
+            ++m_stats.submitted;
+        }
+        RenderFrame(frame);
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        std::swap(m_writeIndex, m_readyIndex);
+        if (m_hasReady) {
+            ++m_stats.dropped;
+        }
+        m_hasReady = true;
+        ++m_stats.submitted;
+    }
+    m_wake.notify_one();
+}
+
+void RenderThread::Invoke(const std::function<void()>& task) {
+    if (!m_running) {
+        task();
+        return;
+    }
+
+    std::exception_ptr error;
+    bool done = false;
+
+    std::unique_lock lock(m_mutex);
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+    m_tasks.push_back(Task{ &task, &error, &done });
+    m_wake.notify_one();
+    m_taskDone.wait(lock, [&] { return done || m_threadExited; });
+
+    if (!done) {
+        std::rethrow_exception(m_error);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+RenderThread::Stats RenderThread::GetStats() const {
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+void RenderThread::UpdateUiTextures(ImDrawData* ui) {
+    if (!ui->Textures) {
+        return;
+    }
+
+    bool pending = false;
+    for (ImTextureData* texture : *ui->Textures) {
+        pending |= texture->Status != ImTextureStatus_OK;
+    }
+    if (!pending) {
+        return;
+    }
+
+    // Rare (first frame, new glyphs): upload synchronously while the atlas can't change
+    Invoke([ui] {
+        for (ImTextureData* texture : *ui->Textures) {
+            if (texture->Status != ImTextureStatus_OK) {
+                ImGui_ImplOpenGL3_UpdateTexture(texture);
+            }
+        }
+    });
+}
+
+/* ============================================================== */
+/* Render thread                                                  */
+/* ============================================================== */
+void RenderThread::ThreadMain() {
+    std::unique_lock lock(m_mutex);
+
+    if (!SDL_GL_MakeCurrent(m_window.GetRawWindow(), m_window.GetGLContext())) {
+        m_error = std::make_exception_ptr(Core::Exception("RenderThread: failed to make GL context current: " + std::string(SDL_GetError())));
+        m_threadExited = true;
+        m_taskDone.notify_all();
+        return;
+    }
+    StateCache::Get().Invalidate();
+
+    while (true) {
+        m_wake.wait(lock, [this] { return m_stopRequested || m_hasReady || !m_tasks.empty(); });
+
+        while (!m_tasks.empty()) {
+            Task task = m_tasks.front();
+            m_tasks.pop_front();
+            lock.unlock();
+            try {
+                (*task.function)();
+            }
+            catch (...) {
+                *task.error = std::current_exception();
+            }
+            lock.lock();
+            *task.done = true;
+            m_taskDone.notify_all();
+        }
+
+        if (m_hasReady) {
+            std::swap(m_readIndex, m_readyIndex);
+            m_hasReady = false;
+            Frame& frame = m_frames[m_readIndex];
+
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                RenderFrame(frame);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+
+            if (error) {
+                m_error = error;
+                break;
+            }
+            continue;
+        }
+
+        if (m_stopRequested) {
+            break;
+        }
+    }
+
+    SDL_GL_MakeCurrent(m_window.GetRawWindow(), nullptr);
+    m_threadExited = true;
+    m_taskDone.notify_all();
+}
+
+void RenderThread::RenderFrame(Frame& frame) {
+    uint64_t start = SDL_GetTicksNS();
+
+    if (m_frameCallback) {
+        m_frameCallback(frame.commands);
+    }
+    frame.commands.Execute();
+    if (frame.hasUi) {
+        ImGui_ImplOpenGL3_RenderDrawData(&frame.ui);
+        StateCache::Get().Invalidate(); // ImGui binds its own GL state
+    }
+    Renderer::Render(&m_window);
+    Core::LatencyTracker::Get().OnPresented(frame.latencySerial, SDL_GetTicksNS());
+
+    StateCache& state = StateCache::Get();
+    state.NewFrame();
+    const StateCache::Stats& glStats = state.GetFrameStats();
+
+    std::lock_guard lock(m_mutex);
+    ++m_stats.presented;
+    m_stats.renderMs = static_cast<float>(SDL_GetTicksNS() - start) / 1e6f;
+    m_stats.drawCalls = static_cast<uint32_t>(frame.commands.GetDrawCallCount());
+    m_stats.glIssued = glStats.issued;
+    m_stats.glSkipped = glStats.skipped;
+}
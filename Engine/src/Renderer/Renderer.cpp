@@ -4,9 +4,13 @@
 
 bool Renderer::InitSDL() {
 	if (!SDL_Init(SDL_INIT_VIDEO)) {
-		logger.Error("Could not initialize SDL: %s", SDL_GetError());
+		logger.Error("Could not initialize SDL: {}", SDL_GetError());
 		return false;
 	}
+	// Controllers are optional, keep going on keyboard without them
+	if (!SDL_InitSubSystem(SDL_INIT_GAMEPAD)) {
+		logger.Warn("Could not initialize gamepads: {}", SDL_GetError());
+	}
 	return true;
 }
 
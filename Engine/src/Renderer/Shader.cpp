@@ -0,0 +1,153 @@
+#include <Renderer/Shader.hpp>
+#include <Renderer/GL.hpp>
+#include <Core/Exceptions.hpp>
+#include <vector>
+
+using namespace Renderer;
+
+namespace {
+    const char* SpriteVertexSource = R"(#version 330 core
+layout(std140) uniform Camera {
+    mat4 u_projection;
+};
+
+layout(location = 0) in vec2 a_position;
+layout(location = 1) in vec2 a_texCoord;
+layout(location = 2) in vec4 a_color;
+
+out vec2 v_texCoord;
+out vec4 v_color;
+
+void main() {
+    v_texCoord = a_texCoord;
+    v_color = a_color;
+    gl_Position = u_projection * vec4(a_position, 0.0, 1.0);
+}
+)";
+
+    const char* SpriteFragmentSource = R"(#version 330 core
+uniform sampler2D u_texture;
+
+in vec2 v_texCoord;
+in vec4 v_color;
+
+out vec4 o_color;
+
+void main() {
+    o_color = texture(u_texture, v_texCoord) * v_color;
+}
+)";
+}
+
+/* ============================================================== */
+/* Shader                                                         */
+/* ============================================================== */
+GLuint Shader::Compile(const std::string& name, GLenum type, const char* source) {
+    GLuint shader = GL::CreateShader(type);
+    GL::ShaderSource(shader, 1, &source, nullptr);
+    GL::CompileShader(shader);
+
+    GLint status = GL_FALSE;
+    GL::GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint length = 0;
+        GL::GetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(static_cast<size_t>(length) + 1, '\0');
+        GL::GetShaderInfoLog(shader, length, nullptr, log.data());
+        GL::DeleteShader(shader);
+
+        const char* stage = type == GL_VERTEX_SHADER ? "vertex" : "fragment";
+        throw Core::Exception("Failed to compile " + std::string(stage) + " shader '" + name + "': " + log.data());
+    }
+    return shader;
+}
+
+Shader::Shader(const std::string& name, const char* vertexSource, const char* fragmentSource)
+    : m_name(name) {
+    GLuint vs = Compile(name, GL_VERTEX_SHADER, vertexSource);
+    GLuint fs = 0;
+    try {
+        fs = Compile(name, GL_FRAGMENT_SHADER, fragmentSource);
+    }
+    catch (...) {
+        GL::DeleteShader(vs);
+        throw;
+    }
+
+    m_program = GL::CreateProgram();
+    GL::AttachShader(m_program, vs);
+    GL::AttachShader(m_program, fs);
+    GL::LinkProgram(m_program);
+    GL::DeleteShader(vs);
+    GL::DeleteShader(fs);
+
+    GLint status = GL_FALSE;
+    GL::GetProgramiv(m_program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint length = 0;
+        GL::GetProgramiv(m_program, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(static_cast<size_t>(length) + 1, '\0');
+        GL::GetProgramInfoLog(m_program, length, nullptr, log.data());
+        GL::DeleteProgram(m_program);
+        m_program = 0;
+        throw Core::Exception("Failed to link shader '" + name + "': " + log.data());
+    }
+}
+
+Shader::~Shader() {
+    if (m_program != 0) {
+        GL::DeleteProgram(m_program);
+    }
+}
+
+GLuint Shader::GetProgram() const {
+    return m_program;
+}
+
+const std::string& Shader::GetName() const {
+    return m_name;
+}
+
+GLint Shader::GetUniformLocation(const char* uniform) const {
+    return GL::GetUniformLocation(m_program, uniform);
+}
+
+void Shader::BindUniformBlock(const char* block, GLuint binding) const {
+    GLuint index = GL::GetUniformBlockIndex(m_program, block);
+    if (index != GL_INVALID_INDEX) {
+        GL::UniformBlockBinding(m_program, index, binding);
+    }
+}
+
+/* ============================================================== */
+/* Shader library                                                 */
+/* ============================================================== */
+ShaderLibrary::ShaderLibrary()
+    : m_logger("ShaderLibrary") {
+}
+
+Shader* ShaderLibrary::Add(const std::string& name, const char* vertexSource, const char* fragmentSource) {
+    auto shader = std::make_unique<Shader>(name, vertexSource, fragmentSource);
+    shader->BindUniformBlock("Camera", CameraBinding);
+
+    Shader* ptr = shader.get();
+    m_shaders[name] = std::move(shader);
+    m_logger.Debug("Added shader '{}' (program {})", name, ptr->GetProgram());
+    return ptr;
+}
+
+Shader* ShaderLibrary::Get(const std::string& name) const {
+    auto it = m_shaders.find(name);
+    if (it != m_shaders.end()) {
+        return it->second.get();
+    }
+    throw Core::Exception("ShaderLibrary::Get: shader not found: " + name);
+}
+
+void ShaderLibrary::LoadBuiltins() {
+    Add("sprite", SpriteVertexSource, SpriteFragmentSource);
+}
+
+void ShaderLibrary::Clear() {
+    m_shaders.clear();
+}
@@ -0,0 +1,55 @@
+#include <Renderer/SpriteBatch.hpp>
+
+using namespace Renderer;
+
+SpriteBatch::SpriteBatch(size_t reserveSprites) {
+    m_vertices.reserve(reserveSprites * 4);
+}
+
+void SpriteBatch::Clear() {
+    m_vertices.clear();
+    m_ranges.clear();
+}
+
+SpriteVertex* SpriteBatch::Reserve(GLuint texture, size_t spriteCount) {
+    uint32_t first = static_cast<uint32_t>(m_vertices.size());
+    uint32_t count = static_cast<uint32_t>(spriteCount * 4);
+
+    if (!m_ranges.empty() && m_ranges.back().texture == texture) {
+        m_ranges.back().vertexCount += count;
+    }
+    else {
+        m_ranges.push_back(Range{ texture, first, count });
+    }
+
+    m_vertices.resize(m_vertices.size() + count);
+    return m_vertices.data() + first;
+}
+
+void SpriteBatch::Draw(GLuint texture, const Math::Vector2f& pos, const Math::Vector2f& size,
+    const UVRect& uv, uint32_t color) {
+    Math::Vector2f half = size * 0.5f;
+    SpriteVertex* v = Reserve(texture, 1);
+    WriteQuad(v, pos.x - half.x, pos.y - half.y, pos.x + half.x, pos.y + half.y, uv, color);
+}
+
+void SpriteBatch::WriteQuad(SpriteVertex* out, float x0, float y0, float x1, float y1,
+    const UVRect& uv, uint32_t color) {
+    // Textures are uploaded top row first, so image space is texture space
+    out[0] = SpriteVertex{ x0, y0, uv.u0, uv.v0, color }; // top-left
+    out[1] = SpriteVertex{ x1, y0, uv.u1, uv.v0, color }; // top-right
+    out[2] = SpriteVertex{ x1, y1, uv.u1, uv.v1, color }; // bottom-right
+    out[3] = SpriteVertex{ x0, y1, uv.u0, uv.v1, color }; // bottom-left
+}
+
+const std::vector<SpriteVertex>& SpriteBatch::GetVertices() const {
+    return m_vertices;
+}
+
+const std::vector<SpriteBatch::Range>& SpriteBatch::GetRanges() const {
+    return m_ranges;
+}
+
+size_t SpriteBatch::GetSpriteCount() const {
+    return m_vertices.size() / 4;
+}
@@ -0,0 +1,206 @@
+#include <Renderer/StateCache.hpp>
+#include <Renderer/GL.hpp>
+
+using namespace Renderer;
+
+StateCache& StateCache::Get() {
+    static StateCache cache;
+    return cache;
+}
+
+StateCache::StateCache() {
+    Invalidate();
+}
+
+bool StateCache::Check(bool redundant) {
+    if (redundant) {
+        ++m_current.skipped;
+        return false;
+    }
+    ++m_current.issued;
+    return true;
+}
+
+int StateCache::BufferSlotOf(GLenum target) {
+    switch (target) {
+    case GL_ARRAY_BUFFER:         return ArrayBuffer;
+    case GL_ELEMENT_ARRAY_BUFFER: return ElementBuffer;
+    case GL_UNIFORM_BUFFER:       return UniformBuffer;
+    case GL_PIXEL_UNPACK_BUFFER:  return PixelUnpackBuffer;
+    case GL_PIXEL_PACK_BUFFER:    return PixelPackBuffer;
+    default:                      return -1;
+    }
+}
+
+int StateCache::CapSlotOf(GLenum cap) {
+    switch (cap) {
+    case GL_BLEND:        return CapBlend;
+    case GL_DEPTH_TEST:   return CapDepthTest;
+    case GL_SCISSOR_TEST: return CapScissorTest;
+    case GL_CULL_FACE:    return CapCullFace;
+    default:              return -1;
+    }
+}
+
+/* ============================================================== */
+/* Bindings                                                       */
+/* ============================================================== */
+void StateCache::ActiveTexture(GLenum unit) {
+    if (Check(m_activeUnit == unit)) {
+        GL::ActiveTexture(unit);
+        m_activeUnit = unit;
+    }
+}
+
+void StateCache::BindTexture(GLuint texture) {
+    int unit = m_activeUnit == Unknown ? -1 : static_cast<int>(m_activeUnit - GL_TEXTURE0);
+    if (unit < 0 || unit >= MaxTextureUnits) {
+        // Unknown or untracked unit, always issue
+        ++m_current.issued;
+        glBindTexture(GL_TEXTURE_2D, texture);
+        return;
+    }
+    if (Check(m_textures[unit] == texture)) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        m_textures[unit] = texture;
+    }
+}
+
+void StateCache::BindTexture(GLenum unit, GLuint texture) {
+    int index = static_cast<int>(unit - GL_TEXTURE0);
+    if (index >= 0 && index < MaxTextureUnits && m_textures[index] == texture) {
+        ++m_current.skipped;
+        return;
+    }
+    ActiveTexture(unit);
+    BindTexture(texture);
+}
+
+void StateCache::UseProgram(GLuint program) {
+    if (Check(m_program == program)) {
+        GL::UseProgram(program);
+        m_program = program;
+    }
+}
+
+void StateCache::BindVertexArray(GLuint vao) {
+    if (Check(m_vao == vao)) {
+        GL::BindVertexArray(vao);
+        m_vao = vao;
+        // The element buffer binding belongs to the VAO
+        m_buffers[ElementBuffer] = Unknown;
+    }
+}
+
+void StateCache::BindBuffer(GLenum target, GLuint buffer) {
+    int slot = BufferSlotOf(target);
+    if (slot < 0) {
+        ++m_current.issued;
+        GL::BindBuffer(target, buffer);
+        return;
+    }
+    if (Check(m_buffers[slot] == buffer)) {
+        GL::BindBuffer(target, buffer);
+        m_buffers[slot] = buffer;
+    }
+}
+
+/* ============================================================== */
+/* Fixed state                                                    */
+/* ============================================================== */
+void StateCache::SetCap(GLenum cap, bool enabled) {
+    int slot = CapSlotOf(cap);
+    int8_t value = enabled ? 1 : 0;
+    if (slot >= 0 && !Check(m_caps[slot] == value)) {
+        return;
+    }
+    if (slot < 0) {
+        ++m_current.issued;
+    }
+
+    if (enabled) {
+        glEnable(cap);
+    }
+    else {
+        glDisable(cap);
+    }
+    if (slot >= 0) {
+        m_caps[slot] = value;
+    }
+}
+
+void StateCache::Enable(GLenum cap) {
+    SetCap(cap, true);
+}
+
+void StateCache::Disable(GLenum cap) {
+    SetCap(cap, false);
+}
+
+void StateCache::BlendFunc(GLenum src, GLenum dst) {
+    if (Check(m_blendSrc == src && m_blendDst == dst)) {
+        glBlendFunc(src, dst);
+        m_blendSrc = src;
+        m_blendDst = dst;
+    }
+}
+
+void StateCache::ClearColor(float r, float g, float b, float a) {
+    bool same = m_clearColor[0] == r && m_clearColor[1] == g && m_clearColor[2] == b && m_clearColor[3] == a;
+    if (Check(same)) {
+        glClearColor(r, g, b, a);
+        m_clearColor[0] = r;
+        m_clearColor[1] = g;
+        m_clearColor[2] = b;
+        m_clearColor[3] = a;
+    }
+}
+
+/* ============================================================== */
+/* Object lifetime and invalidation                               */
+/* ============================================================== */
+void StateCache::OnTextureDeleted(GLuint texture) {
+    for (GLuint& bound : m_textures) {
+        if (bound == texture) {
+            bound = 0;
+        }
+    }
+}
+
+void StateCache::OnBufferDeleted(GLuint buffer) {
+    for (GLuint& bound : m_buffers) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+}
+
+void StateCache::OnVertexArrayDeleted(GLuint vao) {
+    if (m_vao == vao) {
+        m_vao = 0;
+        m_buffers[ElementBuffer] = Unknown;
+    }
+}
+
+void StateCache::Invalidate() {
+    m_activeUnit = Unknown;
+    m_textures.fill(Unknown);
+    m_program = Unknown;
+    m_vao = Unknown;
+    m_buffers.fill(Unknown);
+    m_caps.fill(-1);
+    m_blendSrc = Unknown;
+    m_blendDst = Unknown;
+    for (float& c : m_clearColor) {
+        c = -1.0f;
+    }
+}
+
+void StateCache::NewFrame() {
+    m_lastFrame = m_current;
+    m_current = Stats{};
+}
+
+const StateCache::Stats& StateCache::GetFrameStats() const {
+    return m_lastFrame;
+}
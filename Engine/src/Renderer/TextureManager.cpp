@@ -8,12 +8,189 @@
 #else
 #include <SDL3_image/SDL_image.h>
 #endif
+#include <Core/AssetPack.hpp>
 #include <Core/Exceptions.hpp>
+#include <Core/ThreadPool.hpp>
+#include <Renderer/CommandList.hpp>
+#include <Renderer/GL.hpp>
+#include <Renderer/Mipmap.hpp>
+#include <Renderer/StateCache.hpp>
+#include <Renderer/UploadRing.hpp>
+#include <Util/Hash.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
 
 using namespace Renderer;
 
+struct TextureManager::PendingLoad {
+    enum class Stage {
+        Decoding,   // worker
+        Decoded,    // waiting for an upload slot
+        Copying,    // worker writing into the slot
+        Copied,     // waiting for PumpUploads
+        Failed,
+    };
+
+    Util::StringId name;
+    std::string path;
+    TextureLoadCallback onLoaded;
+    GLuint target = 0;              // reload into this texture instead of a new one
+    GLuint splitFrom = 0;           // move 'name' off this shared texture to one of its own
+    TextureLoadOptions options;
+    SDL_Surface* surface = nullptr;
+    std::vector<uint8_t> chain;     // RGBA8 levels, when the options ask for more than level 0
+    int width = 0;
+    int height = 0;
+    int levels = 1;
+    uint64_t contentHash = 0;
+    int sourceWidth = 0;            // decoded size, before any thumbnail reduction
+    int sourceHeight = 0;
+    int slot = UploadRing::NoSlot;
+    Stage stage = Stage::Decoding;
+    std::string error;
+
+    ~PendingLoad() {
+        if (surface) {
+            SDL_DestroySurface(surface);
+        }
+    }
+};
+
+struct TextureManager::LoadQueue {
+    std::mutex mutex; // also held while TextureData already handed out is rewritten
+    std::vector<std::unique_ptr<PendingLoad>> loads;
+    std::unique_ptr<Core::ThreadPool> workers; // created on first use
+    TextureStats stats;
+
+    ~LoadQueue() {
+        workers.reset(); // join before the loads they point at go away
+    }
+};
+
+namespace {
+    // Byte order R, G, B, A whatever the host endianness; what textures are uploaded as
+    constexpr SDL_PixelFormat UploadFormat = SDL_PIXELFORMAT_RGBA32;
+
+    // Returns the image in its decoded format. Only indexed images are converted
+    // here, the rest is converted on the way into the upload buffer.
+    SDL_Surface* DecodeImage(const std::string& filePath, std::string& error) {
+        SDL_Surface* surface = IMG_Load(filePath.c_str());
+        if (!surface) {
+            error = "Failed to load image '" + filePath + "': " + SDL_GetError();
+            return nullptr;
+        }
+        if (!SDL_ISPIXELFORMAT_INDEXED(surface->format)) {
+            return surface;
+        }
+
+        SDL_Surface* converted = SDL_ConvertSurface(surface, UploadFormat);
+        SDL_DestroySurface(surface);
+        if (!converted) {
+            error = "Failed to convert surface for '" + filePath + "': " + SDL_GetError();
+        }
+        return converted;
+    }
+
+    size_t TextureBytes(int width, int height) {
+        return static_cast<size_t>(width) * height * sizeof(Uint32);
+    }
+
+    bool NeedsChain(const TextureLoadOptions& options) {
+        return options.mipmaps || options.thumbnailSize > 0;
+    }
+
+    // Sources are kept in one spelling so a changed file matches by ID
+    Util::StringId InternPath(const std::string& filePath) {
+        return Util::Intern(std::filesystem::path(filePath).lexically_normal().generic_string());
+    }
+
+    // Names that were never interned can't be in any map, and looking them up doesn't add them
+    std::optional<Util::StringId> FindName(const std::string& name) {
+        return Util::StringInterner::Get().Find(name);
+    }
+
+    // Bands of rows are hashed on separate workers and combined in order, so the
+    // result doesn't depend on how the work was split. Rows are hashed one at a
+    // time whatever the pitch, padding isn't part of the image. The options are
+    // part of the seed, the same image as a thumbnail is a different texture.
+    constexpr int HashBandRows = 128;
+
+    uint64_t ContentHash(const SDL_Surface* surface, const TextureLoadOptions& options, Core::ThreadPool& workers) {
+        struct Key {
+            int32_t width;
+            int32_t height;
+            uint32_t format;
+            uint32_t mipmaps;
+            uint32_t thumbnailSize;
+        } key{ surface->w, surface->h, static_cast<uint32_t>(surface->format), options.mipmaps ? 1u : 0u, options.thumbnailSize };
+        uint64_t seed = Util::Hash64(&key, sizeof(key));
+
+        const Uint8* pixels = static_cast<const Uint8*>(surface->pixels);
+        size_t pitch = static_cast<size_t>(surface->pitch);
+        size_t rowBytes = static_cast<size_t>(surface->w) * SDL_BYTESPERPIXEL(surface->format);
+        std::vector<uint64_t> bands((surface->h + HashBandRows - 1) / HashBandRows);
+
+        workers.ParallelFor(bands.size(), [&](size_t band) {
+            int first = static_cast<int>(band) * HashBandRows;
+            int last = std::min(surface->h, first + HashBandRows);
+            uint64_t hash = seed;
+            for (int y = first; y < last; ++y) {
+                hash = Util::Hash64(pixels + y * pitch, rowBytes, hash);
+            }
+            bands[band] = hash;
+        });
+
+        uint64_t hash = Util::Hash64(bands.data(), bands.size() * sizeof(uint64_t), seed);
+        return hash != 0 ? hash : 1; // 0 marks unhashed textures
+    }
+
+    // Writes tightly packed RGBA8 rows, top row first. Matching formats are
+    // copied, anything else is converted straight into 'destination'.
+    bool WritePixels(Uint8* destination, const void* pixels, SDL_PixelFormat format, int width, int height, int pitch) {
+        size_t rowBytes = static_cast<size_t>(width) * sizeof(Uint32);
+        if (format != UploadFormat) {
+            return SDL_ConvertPixels(width, height, format, pixels, pitch, UploadFormat, destination, static_cast<int>(rowBytes));
+        }
+
+        const Uint8* rows = static_cast<const Uint8*>(pixels);
+        if (static_cast<size_t>(pitch) == rowBytes) {
+            memcpy(destination, rows, rowBytes * height);
+            return true;
+        }
+        for (int y = 0; y < height; ++y) {
+            memcpy(destination + y * rowBytes, rows + static_cast<size_t>(y) * pitch, rowBytes);
+        }
+        return true;
+    }
+
+    // Converts to RGBA8 and builds the levels 'options' ask for. Thumbnails keep
+    // only levels within their size; 'width'/'height' become the first kept one's.
+    bool BuildChain(const SDL_Surface* surface, const TextureLoadOptions& options, std::vector<uint8_t>& chain,
+        int& width, int& height, int& levels) {
+        uint32_t fullWidth = static_cast<uint32_t>(surface->w);
+        uint32_t fullHeight = static_cast<uint32_t>(surface->h);
+        uint32_t first = options.thumbnailSize > 0 ? Mipmap::FirstLevelWithin(fullWidth, fullHeight, options.thumbnailSize) : 0;
+        uint32_t last = options.mipmaps ? Mipmap::LevelCount(fullWidth, fullHeight) : first + 1;
+
+        chain.resize(Mipmap::ChainBytes(fullWidth, fullHeight, last));
+        if (!WritePixels(chain.data(), surface->pixels, surface->format, surface->w, surface->h, surface->pitch)) {
+            return false;
+        }
+        Mipmap::Build(chain.data(), fullWidth, fullHeight, last);
+
+        size_t skipped = Mipmap::ChainBytes(fullWidth, fullHeight, first);
+        chain.erase(chain.begin(), chain.begin() + static_cast<ptrdiff_t>(skipped));
+        chain.shrink_to_fit();
+        width = static_cast<int>(std::max(1u, fullWidth >> first));
+        height = static_cast<int>(std::max(1u, fullHeight >> first));
+        levels = static_cast<int>(last - first);
+        return true;
+    }
+}
+
 TextureManager::TextureManager()
-    : m_logger("TextureManager") {
+    : m_loads(std::make_unique<LoadQueue>()), m_logger("TextureManager") {
     m_logger.Debug("TextureManager created");
 }
 
@@ -30,9 +207,24 @@ TextureManager::~TextureManager() {
 TextureManager::TextureManager(TextureManager&& other) noexcept
     : m_nameToTextureData(std::move(other.m_nameToTextureData)),
     m_textureToName(std::move(other.m_textureToName)),
+    m_residency(std::move(other.m_residency)),
+    m_contentToTexture(std::move(other.m_contentToTexture)),
+    m_nameToSource(std::move(other.m_nameToSource)),
+    m_budgetBytes(other.m_budgetBytes),
+    m_residentBytes(other.m_residentBytes),
+    m_frame(other.m_frame),
+    m_evictions(other.m_evictions),
+    m_reloads(other.m_reloads),
+    m_uploadRing(std::move(other.m_uploadRing)),
+    m_loads(std::move(other.m_loads)),
     m_logger("TextureManager") {
+    other.m_loads = std::make_unique<LoadQueue>();
     other.m_nameToTextureData.clear();
     other.m_textureToName.clear();
+    other.m_residency.clear();
+    other.m_contentToTexture.clear();
+    other.m_nameToSource.clear();
+    other.m_residentBytes = 0;
     m_logger.Debug("TextureManager moved");
 }
 
@@ -47,25 +239,89 @@ TextureManager& TextureManager::operator=(TextureManager&& other) noexcept {
 
         m_nameToTextureData = std::move(other.m_nameToTextureData);
         m_textureToName = std::move(other.m_textureToName);
+        m_residency = std::move(other.m_residency);
+        m_contentToTexture = std::move(other.m_contentToTexture);
+        m_nameToSource = std::move(other.m_nameToSource);
+        m_budgetBytes = other.m_budgetBytes;
+        m_residentBytes = other.m_residentBytes;
+        m_frame = other.m_frame;
+        m_evictions = other.m_evictions;
+        m_reloads = other.m_reloads;
+        m_loads = std::move(other.m_loads);
+        m_uploadRing = std::move(other.m_uploadRing);
+        other.m_loads = std::make_unique<LoadQueue>();
 
         other.m_nameToTextureData.clear();
         other.m_textureToName.clear();
+        other.m_residency.clear();
+        other.m_contentToTexture.clear();
+        other.m_nameToSource.clear();
+        other.m_residentBytes = 0;
 
         m_logger.Debug("TextureManager move-assigned");
     }
     return *this;
 }
 
-void TextureManager::DeleteTextureInternal(const std::string& name, GLuint textureID) {
+void TextureManager::DeleteTextureInternal(Util::StringId name, GLuint textureID) {
+    ReleaseName(name, textureID);
+    m_nameToTextureData.erase(name);
+    m_nameToSource.erase(name);
+}
+
+// Drops 'name' from the texture's users, deleting the texture with its last
+// one. The name's own entry is left for the caller.
+void TextureManager::ReleaseName(Util::StringId name, GLuint textureID) {
+    auto residency = m_residency.find(textureID);
+    if (residency != m_residency.end() && --residency->second.refCount > 0) {
+        // Other names still use it, hand the reverse lookup to one of them
+        auto owner = m_textureToName.find(textureID);
+        if (owner != m_textureToName.end() && owner->second == name) {
+            for (const auto& [other, data] : m_nameToTextureData) {
+                if (data.id == textureID && other != name) {
+                    owner->second = other;
+                    // Same pixels, but it's the new owner's file that reloads should follow
+                    auto source = m_nameToSource.find(other);
+                    if (source != m_nameToSource.end() && !residency->second.pack) {
+                        residency->second.source = source->second;
+                    }
+                    break;
+                }
+            }
+        }
+        m_logger.Debug("Released texture '{}' (ID {}), {} names left", name, textureID, residency->second.refCount);
+        return;
+    }
+
     if (textureID != 0) {
         glDeleteTextures(1, &textureID);
+        StateCache::Get().OnTextureDeleted(textureID);
         m_logger.Info("Deleted texture '{}' (ID {})", name, textureID);
     }
-    m_nameToTextureData.erase(name);
+    if (residency != m_residency.end()) {
+        if (residency->second.resident) {
+            m_residentBytes -= residency->second.bytes;
+        }
+        auto content = m_contentToTexture.find(residency->second.contentHash);
+        if (content != m_contentToTexture.end() && content->second == textureID) {
+            m_contentToTexture.erase(content);
+        }
+        m_residency.erase(residency);
+    }
     m_textureToName.erase(textureID);
 }
 
+void TextureManager::Rewrite(TextureData& texture, GLuint textureID, const Math::Vector2f& size) {
+    std::lock_guard lock(m_loads->mutex);
+    texture.id = textureID;
+    texture.size = size;
+}
+
 TextureData* TextureManager::AddTexture(const std::string& name, GLuint textureID, const Math::Vector2f& size) {
+    return AddTexture(Util::Intern(name), textureID, size);
+}
+
+TextureData* TextureManager::AddTexture(Util::StringId name, GLuint textureID, const Math::Vector2f& size) {
     if (textureID == 0) {
         m_logger.Error("Attempted to add invalid texture ID 0 for '{}'", name);
         throw Core::Exception("TextureManager::AddTexture: texture ID is 0");
@@ -73,23 +329,56 @@ TextureData* TextureManager::AddTexture(const std::string& name, GLuint textureI
 
     auto it = m_nameToTextureData.find(name);
     if (it != m_nameToTextureData.end()) {
-        GLuint oldID = it->second.id;
-        if (oldID != textureID) {
-            DeleteTextureInternal(name, oldID);
+        if (it->second.id == textureID) {
+            Rewrite(it->second, textureID, size);
+            return &it->second;
         }
+        DeleteTextureInternal(name, it->second.id);
     }
 
-    m_nameToTextureData[name] = { textureID, size };
+    TextureData& texture = m_nameToTextureData[name];
+    texture = { textureID, size };
+    Attach(name, textureID, size);
+    return &texture;
+}
+
+// Points an existing name at another texture. Its TextureData is rewritten in
+// place, so pointers handed out for it stay valid.
+void TextureManager::Rebind(Util::StringId name, GLuint textureID, const Math::Vector2f& size) {
+    TextureData& texture = m_nameToTextureData.at(name);
+    ReleaseName(name, texture.id);
+    Rewrite(texture, textureID, size);
+    Attach(name, textureID, size);
+}
+
+// Counts 'name' as a user of the texture, starting its bookkeeping if it's new
+void TextureManager::Attach(Util::StringId name, GLuint textureID, const Math::Vector2f& size) {
+    auto shared = m_residency.find(textureID);
+    if (shared != m_residency.end()) {
+        ++shared->second.refCount;
+        m_logger.Debug("Added texture '{}' as another name for ID {}", name, textureID);
+        return;
+    }
     m_textureToName[textureID] = name;
+
+    Residency& residency = m_residency[textureID];
+    if (residency.resident) {
+        m_residentBytes -= residency.bytes;
+    }
+    residency = Residency{};
+    residency.bytes = TextureBytes(static_cast<int>(size.x), static_cast<int>(size.y));
+    residency.lastUsed = m_frame;
+    m_residentBytes += residency.bytes;
+
     m_logger.Debug("Added texture '{}' (ID {}) with size {}x{}", name, textureID, size.x, size.y);
-    return &m_nameToTextureData[name];
 }
 
 void TextureManager::RemoveTextureByName(const std::string& name) {
-    auto it = m_nameToTextureData.find(name);
+    std::optional<Util::StringId> id = FindName(name);
+    auto it = id ? m_nameToTextureData.find(*id) : m_nameToTextureData.end();
     if (it != m_nameToTextureData.end()) {
         GLuint texID = it->second.id;
-        DeleteTextureInternal(name, texID);
+        DeleteTextureInternal(*id, texID);
     }
     else {
         m_logger.Error("Attempted to remove unknown texture '{}'", name);
@@ -100,7 +389,16 @@ void TextureManager::RemoveTextureByName(const std::string& name) {
 void TextureManager::RemoveTextureByID(GLuint textureID) {
     auto it = m_textureToName.find(textureID);
     if (it != m_textureToName.end()) {
-        DeleteTextureInternal(it->second, textureID);
+        // Every name sharing the texture goes with it
+        std::vector<Util::StringId> names;
+        for (const auto& [name, data] : m_nameToTextureData) {
+            if (data.id == textureID) {
+                names.push_back(name);
+            }
+        }
+        for (Util::StringId name : names) {
+            DeleteTextureInternal(name, textureID);
+        }
     }
     else {
         m_logger.Error("Attempted to remove unknown texture ID {}", textureID);
@@ -109,22 +407,38 @@ void TextureManager::RemoveTextureByID(GLuint textureID) {
 }
 
 GLuint TextureManager::FindTextureByName(const std::string& name) const {
+    std::optional<Util::StringId> id = FindName(name);
+    if (id) {
+        return FindTextureByName(*id);
+    }
+    throw Core::Exception("TextureManager::FindTextureByName: texture not found: " + name);
+}
+
+GLuint TextureManager::FindTextureByName(Util::StringId name) const {
     auto it = m_nameToTextureData.find(name);
     if (it != m_nameToTextureData.end()) {
         return it->second.id;
     }
-    throw Core::Exception("TextureManager::FindTextureByName: texture not found: " + name);
+    throw Core::Exception("TextureManager::FindTextureByName: texture not found: " + std::string(name.View()));
 }
 
 std::optional<std::string> TextureManager::FindNameByTextureID(GLuint textureID) const {
     auto it = m_textureToName.find(textureID);
     if (it != m_textureToName.end()) {
-        return it->second;
+        return std::string(it->second.View());
     }
     return std::nullopt;
 }
 
 std::optional<Math::Vector2f> TextureManager::FindSizeByName(const std::string& name) const {
+    std::optional<Util::StringId> id = FindName(name);
+    if (!id) {
+        return std::nullopt;
+    }
+    return FindSizeByName(*id);
+}
+
+std::optional<Math::Vector2f> TextureManager::FindSizeByName(Util::StringId name) const {
     auto it = m_nameToTextureData.find(name);
     if (it != m_nameToTextureData.end()) {
         return it->second.size;
@@ -133,10 +447,10 @@ std::optional<Math::Vector2f> TextureManager::FindSizeByName(const std::string&
 }
 
 std::optional<Math::Vector2f> TextureManager::FindSizeByID(GLuint textureID) const {
-    auto nameOpt = FindNameByTextureID(textureID);
-    if (!nameOpt.has_value())
+    auto it = m_textureToName.find(textureID);
+    if (it == m_textureToName.end())
         return std::nullopt;
-    return FindSizeByName(nameOpt.value());
+    return FindSizeByName(it->second);
 }
 
 void TextureManager::Clear() {
@@ -145,73 +459,762 @@ void TextureManager::Clear() {
         return;
     }
 
+    // One entry per GL texture, shared ones have several names
     std::vector<GLuint> texIDs;
-    texIDs.reserve(m_nameToTextureData.size());
-    for (const auto& pair : m_nameToTextureData) {
-        texIDs.push_back(pair.second.id);
+    texIDs.reserve(m_residency.size());
+    for (const auto& pair : m_residency) {
+        texIDs.push_back(pair.first);
     }
 
     glDeleteTextures(static_cast<GLsizei>(texIDs.size()), texIDs.data());
+    for (GLuint id : texIDs) {
+        StateCache::Get().OnTextureDeleted(id);
+    }
     m_logger.Info("Deleted {} textures", texIDs.size());
 
     m_nameToTextureData.clear();
     m_textureToName.clear();
+    m_residency.clear();
+    m_contentToTexture.clear();
+    m_nameToSource.clear();
+    m_residentBytes = 0;
 }
 
-TextureData* TextureManager::AddTextureFromFile(const std::string& name, const std::string& filePath) {
-    SDL_Surface* surface = IMG_Load(filePath.c_str());
+TextureData* TextureManager::AddTextureFromFile(const std::string& name, const std::string& filePath, const TextureLoadOptions& options) {
+    Util::StringId id = Util::Intern(name);
+    std::string error;
+    SDL_Surface* surface = DecodeImage(filePath, error);
     if (!surface) {
-        std::string errorMsg = "Failed to load image '" + filePath + "': " + SDL_GetError();
-        m_logger.Error("{}", errorMsg);
-        throw Core::Exception(errorMsg);
+        m_logger.Error("{}", error);
+        throw Core::Exception(error);
     }
 
-    SDL_PixelFormat format = SDL_PIXELFORMAT_ABGR8888;
-    SDL_Surface* converted = SDL_ConvertSurface(surface, format);
+    uint64_t contentHash = 0;
+    int sourceWidth = surface->w;
+    int sourceHeight = surface->h;
+    TextureData* tex = nullptr;
+    try {
+        contentHash = ContentHash(surface, options, GetWorkers());
+        tex = FindByContent(id, contentHash, sourceWidth, sourceHeight, options, InternPath(filePath));
+        if (tex) {
+            SDL_DestroySurface(surface);
+            return tex;
+        }
+
+        if (options.thumbnailSize > 0) {
+            std::vector<uint8_t> chain;
+            int width = 0;
+            int height = 0;
+            int levels = 1;
+            if (!BuildChain(surface, options, chain, width, height, levels)) {
+                throw Core::Exception("Failed to convert pixels for '" + filePath + "': " + SDL_GetError());
+            }
+            tex = UploadChain(id, chain.data(), width, height, levels);
+        }
+        else {
+            // Level 0 only, GL fills in the rest
+            int levels = options.mipmaps ? static_cast<int>(Mipmap::LevelCount(surface->w, surface->h)) : 1;
+            tex = UploadPixels(id, surface->pixels, surface->format, surface->w, surface->h, surface->pitch, levels);
+        }
+    }
+    catch (...) {
+        SDL_DestroySurface(surface);
+        throw;
+    }
     SDL_DestroySurface(surface);
+    SetSource(tex->id, InternPath(filePath), options);
+    SetContentHash(tex->id, contentHash, sourceWidth, sourceHeight);
+
+    m_logger.Info("Loaded texture '{}' from '{}' (ID {}) size {}x{}", name, filePath, tex->id, tex->size.x, tex->size.y);
+    return tex;
+}
+
+TextureData* TextureManager::AddTextureFromPixels(const std::string& name, const void* pixels, int width, int height, int pitch) {
+    if (!pixels || width <= 0 || height <= 0) {
+        m_logger.Error("Invalid pixel data for '{}' ({}x{})", name, width, height);
+        throw Core::Exception("TextureManager::AddTextureFromPixels: invalid pixel data for " + name);
+    }
+    if (pitch == 0) {
+        pitch = width * static_cast<int>(sizeof(Uint32));
+    }
+    return UploadPixels(Util::Intern(name), pixels, UploadFormat, width, height, pitch);
+}
 
-    if (!converted) {
-        std::string errorMsg = "Failed to convert surface for '" + filePath + "': " + SDL_GetError();
+TextureData* TextureManager::UploadPixels(Util::StringId name, const void* pixels, SDL_PixelFormat format, int width, int height, int pitch, int levels) {
+    // Rows go straight into a pixel buffer, the driver copies from there on its own time
+    UploadRing& ring = GetUploadRing();
+    int slot = ring.Acquire(TextureBytes(width, height), true);
+    if (slot == UploadRing::NoSlot) {
+        throw Core::Exception("TextureManager: no upload slot available for " + std::string(name.View()));
+    }
+    if (!WritePixels(ring.GetPointer(slot), pixels, format, width, height, pitch)) {
+        ring.Release(slot);
+        std::string errorMsg = "Failed to convert pixels for '" + std::string(name.View()) + "': " + SDL_GetError();
         m_logger.Error("{}", errorMsg);
         throw Core::Exception(errorMsg);
     }
 
-    int width = converted->w;
-    int height = converted->h;
-    Uint32* pixels = static_cast<Uint32*>(converted->pixels);
-    std::vector<Uint32> flipped(width * height);
+    GLuint textureID = 0;
+    try {
+        textureID = CreateTexture(name, width, height, levels);
+    }
+    catch (...) {
+        ring.Release(slot);
+        throw;
+    }
+    ring.Upload(slot, textureID, width, height);
+    if (levels > 1) {
+        StateCache::Get().BindTexture(textureID);
+        GL::GenerateMipmap(GL_TEXTURE_2D);
+    }
+
+    TextureData* tex = AddTexture(name, textureID, Math::Vector2f(static_cast<float>(width), static_cast<float>(height)));
+    SetResidentBytes(textureID, Mipmap::ChainBytes(width, height, levels));
+    return tex;
+}
 
-    for (int y = 0; y < height; ++y) {
-        memcpy(&flipped[y * width],
-            &pixels[(height - 1 - y) * (converted->pitch / 4)],
-            width * sizeof(Uint32));
+TextureData* TextureManager::UploadChain(Util::StringId name, const uint8_t* chain, int width, int height, int levels) {
+    size_t bytes = Mipmap::ChainBytes(width, height, levels);
+    UploadRing& ring = GetUploadRing();
+    int slot = ring.Acquire(bytes, true);
+    if (slot == UploadRing::NoSlot) {
+        throw Core::Exception("TextureManager: no upload slot available for " + std::string(name.View()));
     }
+    memcpy(ring.GetPointer(slot), chain, bytes);
 
+    GLuint textureID = 0;
+    try {
+        textureID = CreateTexture(name, width, height, levels);
+    }
+    catch (...) {
+        ring.Release(slot);
+        throw;
+    }
+    ring.Upload(slot, textureID, width, height, levels);
+
+    TextureData* tex = AddTexture(name, textureID, Math::Vector2f(static_cast<float>(width), static_cast<float>(height)));
+    SetResidentBytes(textureID, bytes);
+    return tex;
+}
+
+UploadRing& TextureManager::GetUploadRing() {
+    if (!m_uploadRing) {
+        m_uploadRing = std::make_unique<UploadRing>();
+    }
+    return *m_uploadRing;
+}
+
+GLuint TextureManager::CreateTexture(Util::StringId name, int width, int height, int levels) {
     GLuint textureID = 0;
     glGenTextures(1, &textureID);
     if (textureID == 0) {
-        SDL_DestroySurface(converted);
-        std::string errorMsg = "Failed to generate OpenGL texture for '" + filePath + "'";
+        std::string errorMsg = "Failed to generate OpenGL texture for '" + std::string(name.View()) + "'";
         m_logger.Error("{}", errorMsg);
         throw Core::Exception(errorMsg);
     }
 
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    StateCache::Get().BindTexture(textureID);
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    AllocateStorage(width, height, levels);
+    return textureID;
+}
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0,
-        GL_RGBA, GL_UNSIGNED_BYTE, flipped.data());
+void TextureManager::AllocateStorage(int width, int height, int levels) {
+    // Storage only, the pixels arrive through an upload slot. Nothing may be
+    // bound to PIXEL_UNPACK here or the null pointer would read from it.
+    StateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    for (int level = 0; level < levels; ++level) {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, std::max(1, width >> level), std::max(1, height >> level), 0,
+            GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+}
 
-    SDL_DestroySurface(converted);
+TextureData* TextureManager::AddTextureFromPack(const std::string& name, const Core::AssetPack& pack, std::string_view assetName) {
+    const Core::AssetPack::Entry* entry = pack.Find(assetName);
+    if (!entry || entry->type != Core::PackFormat::AssetType::Texture) {
+        std::string errorMsg = "No texture '" + std::string(assetName) + "' in pack '" + pack.GetPath() + "'";
+        m_logger.Error("{}", errorMsg);
+        throw Core::Exception(errorMsg);
+    }
 
-    TextureData* tex = AddTexture(name, textureID, Math::Vector2f(static_cast<float>(width), static_cast<float>(height)));
-    m_logger.Info("Loaded texture '{}' from '{}' (ID {}) size {}x{}", name, filePath, textureID, width, height);
+    Util::StringId id = Util::Intern(name);
+    Util::StringId asset = Util::Intern(assetName);
+    int width = static_cast<int>(entry->width);
+    int height = static_cast<int>(entry->height);
+    GLuint textureID = CreateTexture(id, width, height, static_cast<int>(entry->mipCount));
+    UploadFromPack(textureID, pack, asset);
+
+    TextureData* tex = AddTexture(id, textureID, Math::Vector2f(static_cast<float>(width), static_cast<float>(height)));
+    SetResidentBytes(textureID, entry->size);
+    Residency& residency = m_residency[textureID];
+    residency.source = asset;
+    residency.pack = &pack;
+
+    m_logger.Info("Loaded texture '{}' from pack (ID {}) size {}x{}, {} mip levels", name, textureID, width, height, entry->mipCount);
+    return tex;
+}
+
+void TextureManager::UploadFromPack(GLuint textureID, const Core::AssetPack& pack, Util::StringId assetName) {
+    // Already in upload layout, one copy into the slot and no decoding. The
+    // interned hash is the pack's FNV-1a, so the name isn't hashed again.
+    const Core::AssetPack::Entry* entry = pack.Find(assetName.GetHash());
+    UploadRing& ring = GetUploadRing();
+    int slot = ring.Acquire(entry->size, true);
+    if (slot == UploadRing::NoSlot) {
+        throw Core::Exception("TextureManager: no upload slot available for " + std::string(assetName.View()));
+    }
+    memcpy(ring.GetPointer(slot), pack.GetData(*entry), entry->size);
+    ring.Upload(slot, textureID, static_cast<int>(entry->width), static_cast<int>(entry->height), static_cast<int>(entry->mipCount));
+}
+
+/* ============================================================== */
+/* Asynchronous loading                                           */
+/* ============================================================== */
+void TextureManager::LoadTextureAsync(const std::string& name, const std::string& filePath, TextureLoadCallback onLoaded,
+    const TextureLoadOptions& options) {
+    QueueLoad(Util::Intern(name), filePath, std::move(onLoaded), 0, options);
+}
+
+void TextureManager::QueueLoad(Util::StringId name, const std::string& filePath, TextureLoadCallback onLoaded, GLuint target,
+    const TextureLoadOptions& options, GLuint splitFrom) {
+    auto load = std::make_unique<PendingLoad>();
+    load->name = name;
+    load->path = filePath;
+    load->onLoaded = std::move(onLoaded);
+    load->target = target;
+    load->splitFrom = splitFrom;
+    load->options = options;
+    PendingLoad* job = load.get();
+    LoadQueue* queue = m_loads.get();
+    Core::ThreadPool& workers = GetWorkers();
+
+    std::lock_guard lock(queue->mutex);
+    queue->loads.push_back(std::move(load));
+
+    workers.Submit([queue, job, &workers] {
+        std::string error;
+        SDL_Surface* surface = DecodeImage(job->path, error);
+        uint64_t contentHash = surface ? ContentHash(surface, job->options, workers) : 0;
+
+        // Levels are built here, the slot is write-combined memory and no place to read back from
+        std::vector<uint8_t> chain;
+        int width = surface ? surface->w : 0;
+        int height = surface ? surface->h : 0;
+        int sourceWidth = width;
+        int sourceHeight = height;
+        int levels = 1;
+        if (surface && NeedsChain(job->options)) {
+            if (!BuildChain(surface, job->options, chain, width, height, levels)) {
+                error = "Failed to convert pixels for '" + job->path + "': " + SDL_GetError();
+            }
+            SDL_DestroySurface(surface);
+            surface = nullptr;
+        }
+
+        std::lock_guard lock(queue->mutex);
+        if (error.empty()) {
+            job->surface = surface;
+            job->chain = std::move(chain);
+            job->width = width;
+            job->height = height;
+            job->levels = levels;
+            job->contentHash = contentHash;
+            job->sourceWidth = sourceWidth;
+            job->sourceHeight = sourceHeight;
+            job->stage = PendingLoad::Stage::Decoded;
+        }
+        else {
+            job->error = error;
+            job->stage = PendingLoad::Stage::Failed;
+        }
+    });
+}
+
+size_t TextureManager::PumpUploads(size_t maxUploads) {
+    LoadQueue* queue = m_loads.get();
+    std::vector<std::unique_ptr<PendingLoad>> finished;
+
+    std::unique_lock lock(queue->mutex);
+    if (!queue->loads.empty()) {
+        UploadRing& ring = GetUploadRing();
+        ring.Retire();
+
+        // One slot stays out of reach so synchronous loads always have one to
+        // wait for. Copied jobs held back by 'maxUploads' still own theirs.
+        size_t holding = 0;
+        for (const auto& load : queue->loads) {
+            holding += load->slot != UploadRing::NoSlot ? 1 : 0;
+        }
+
+        for (auto& load : queue->loads) {
+            PendingLoad* job = load.get();
+
+            if (job->stage == PendingLoad::Stage::Decoded && job->target == 0 &&
+                MatchContent(job->contentHash, job->sourceWidth, job->sourceHeight, job->options) != 0) {
+                // Same pixels as a loaded texture, it never needs a slot
+                finished.push_back(std::move(load));
+            }
+            else if (job->stage == PendingLoad::Stage::Decoded && holding < UploadRing::SlotCount - 1) {
+                size_t bytes = Mipmap::ChainBytes(job->width, job->height, job->levels);
+                int slot = ring.Acquire(bytes, false);
+                if (slot == UploadRing::NoSlot) {
+                    continue;
+                }
+
+                job->slot = slot;
+                job->stage = PendingLoad::Stage::Copying;
+                ++holding;
+
+                Uint8* destination = ring.GetPointer(slot);
+                queue->workers->Submit([queue, job, destination, bytes] {
+                    bool written = true;
+                    SDL_Surface* surface = job->surface;
+                    if (surface) {
+                        written = WritePixels(destination, surface->pixels, surface->format, job->width, job->height, surface->pitch);
+                        SDL_DestroySurface(surface);
+                    }
+                    else {
+                        memcpy(destination, job->chain.data(), bytes);
+                    }
+                    std::string error = written ? std::string() : "Failed to convert pixels for '" + job->path + "': " + SDL_GetError();
+
+                    std::lock_guard lock(queue->mutex);
+                    job->surface = nullptr;
+                    job->chain = {};
+                    job->error = error;
+                    job->stage = written ? PendingLoad::Stage::Copied : PendingLoad::Stage::Failed;
+                });
+            }
+            else if ((job->stage == PendingLoad::Stage::Copied && finished.size() < maxUploads) ||
+                job->stage == PendingLoad::Stage::Failed) {
+                finished.push_back(std::move(load));
+            }
+        }
+
+        std::erase_if(queue->loads, [](const std::unique_ptr<PendingLoad>& load) { return !load; });
+    }
+    lock.unlock();
+
+    // GL work and callbacks outside the lock, workers keep going meanwhile
+    size_t uploaded = 0;
+    for (const auto& job : finished) {
+        FinishLoad(*job);
+        uploaded += job->stage == PendingLoad::Stage::Copied ? 1 : 0;
+    }
+
+    EnforceBudget();
+    PublishStats();
+    ++m_frame;
+    return uploaded;
+}
+
+void TextureManager::FinishLoad(PendingLoad& job) {
+    UploadRing& ring = GetUploadRing();
+    Residency* reload = nullptr;
+    if (job.target != 0) {
+        // The texture may have been removed while its file was loading
+        auto it = m_residency.find(job.target);
+        reload = it != m_residency.end() && it->second.reloading ? &it->second : nullptr;
+        if (!reload) {
+            if (job.slot != UploadRing::NoSlot) {
+                ring.Release(job.slot);
+            }
+            job.stage = PendingLoad::Stage::Failed;
+            return;
+        }
+        reload->reloading = false;
+    }
+
+    if (job.stage == PendingLoad::Stage::Failed) {
+        if (job.slot != UploadRing::NoSlot) {
+            ring.Release(job.slot);
+        }
+        m_logger.Error("{}", job.error);
+        if (reload && !reload->resident) {
+            // Stays a placeholder rather than retrying every frame
+            reload->source = {};
+        }
+        if (job.onLoaded) {
+            job.onLoaded(nullptr);
+        }
+        return;
+    }
+
+    if (job.splitFrom != 0) {
+        FinishSplit(job);
+        return;
+    }
+
+    if (!reload) {
+        if (TextureData* shared = FindByContent(job.name, job.contentHash, job.sourceWidth, job.sourceHeight, job.options, InternPath(job.path))) {
+            if (job.slot != UploadRing::NoSlot) {
+                ring.Release(job.slot);
+            }
+            if (job.onLoaded) {
+                job.onLoaded(shared);
+            }
+            return;
+        }
+    }
+
+    if (reload) {
+        StateCache::Get().BindTexture(job.target);
+        AllocateStorage(job.width, job.height, job.levels);
+        ring.Upload(job.slot, job.target, job.width, job.height, job.levels);
+
+        if (reload->resident) {
+            m_residentBytes -= reload->bytes;
+        }
+        reload->bytes = Mipmap::ChainBytes(job.width, job.height, job.levels);
+        reload->resident = true;
+        m_residentBytes += reload->bytes;
+        SetContentHash(job.target, job.contentHash, job.sourceWidth, job.sourceHeight);
+        for (auto& [name, data] : m_nameToTextureData) {
+            if (data.id == job.target) {
+                Rewrite(data, job.target, Math::Vector2f(static_cast<float>(job.width), static_cast<float>(job.height)));
+            }
+        }
+        m_logger.Debug("Reloaded texture '{}' (ID {})", job.name, job.target);
+        return;
+    }
+
+    TextureData* tex = nullptr;
+    try {
+        GLuint textureID = CreateTexture(job.name, job.width, job.height, job.levels);
+        ring.Upload(job.slot, textureID, job.width, job.height, job.levels);
+        tex = AddTexture(job.name, textureID, Math::Vector2f(static_cast<float>(job.width), static_cast<float>(job.height)));
+        SetResidentBytes(textureID, Mipmap::ChainBytes(job.width, job.height, job.levels));
+        SetSource(textureID, InternPath(job.path), job.options);
+        SetContentHash(textureID, job.contentHash, job.sourceWidth, job.sourceHeight);
+        m_logger.Info("Loaded texture '{}' from '{}' (ID {}) size {}x{}", job.name, job.path, textureID, job.width, job.height);
+    }
+    catch (const Core::Exception& e) {
+        ring.Release(job.slot);
+        job.stage = PendingLoad::Stage::Failed;
+        m_logger.Error("Async load of '{}' failed: {}", job.name, e.what());
+    }
+
+    if (job.onLoaded) {
+        job.onLoaded(tex);
+    }
+}
+
+void TextureManager::FinishSplit(PendingLoad& job) {
+    UploadRing& ring = GetUploadRing();
+    auto name = m_nameToTextureData.find(job.name);
+    GLuint shared = MatchContent(job.contentHash, job.sourceWidth, job.sourceHeight, job.options);
+    // Removed or given another texture while loading, or the file didn't change after all
+    if (name == m_nameToTextureData.end() || name->second.id != job.splitFrom || shared == job.splitFrom) {
+        if (job.slot != UploadRing::NoSlot) {
+            ring.Release(job.slot);
+        }
+        return;
+    }
+
+    if (shared != 0) {
+        // The new pixels are another texture's, share that one instead
+        Rebind(job.name, shared, m_nameToTextureData[m_textureToName[shared]].size);
+        if (job.slot != UploadRing::NoSlot) {
+            ring.Release(job.slot);
+        }
+        m_logger.Info("Texture '{}' now shares ID {} after '{}' changed", job.name, shared, job.path);
+        return;
+    }
+
+    try {
+        GLuint textureID = CreateTexture(job.name, job.width, job.height, job.levels);
+        ring.Upload(job.slot, textureID, job.width, job.height, job.levels);
+        Rebind(job.name, textureID, Math::Vector2f(static_cast<float>(job.width), static_cast<float>(job.height)));
+        SetResidentBytes(textureID, Mipmap::ChainBytes(job.width, job.height, job.levels));
+        SetSource(textureID, InternPath(job.path), job.options);
+        SetContentHash(textureID, job.contentHash, job.sourceWidth, job.sourceHeight);
+        m_logger.Info("Texture '{}' moved off shared ID {} to ID {} after '{}' changed", job.name, job.splitFrom, textureID, job.path);
+    }
+    catch (const Core::Exception& e) {
+        ring.Release(job.slot);
+        job.stage = PendingLoad::Stage::Failed;
+        m_logger.Error("Reload of '{}' failed: {}", job.name, e.what());
+    }
+}
+
+Core::ThreadPool& TextureManager::GetWorkers() {
+    std::lock_guard lock(m_loads->mutex);
+    if (!m_loads->workers) {
+        m_loads->workers = std::make_unique<Core::ThreadPool>();
+        m_logger.Debug("Started {} texture decode workers", m_loads->workers->GetThreadCount());
+    }
+    return *m_loads->workers;
+}
+
+size_t TextureManager::GetPendingLoadCount() const {
+    std::lock_guard lock(m_loads->mutex);
+    return m_loads->loads.size();
+}
+
+/* ============================================================== */
+/* Content sharing                                                */
+/* ============================================================== */
+GLuint TextureManager::MatchContent(uint64_t contentHash, int width, int height, const TextureLoadOptions& options) const {
+    auto it = m_contentToTexture.find(contentHash);
+    if (it == m_contentToTexture.end()) {
+        return 0;
+    }
+    // The hash alone can collide; a texture of another size or kind is never shared
+    const Residency& residency = m_residency.at(it->second);
+    if (residency.contentWidth != width || residency.contentHeight != height ||
+        residency.options.mipmaps != options.mipmaps || residency.options.thumbnailSize != options.thumbnailSize) {
+        return 0;
+    }
+    return it->second;
+}
+
+TextureData* TextureManager::FindByContent(Util::StringId name, uint64_t contentHash, int width, int height,
+    const TextureLoadOptions& options, Util::StringId source) {
+    GLuint textureID = MatchContent(contentHash, width, height, options);
+    if (textureID == 0) {
+        return nullptr;
+    }
+
+    Util::StringId owner = m_textureToName[textureID];
+    Math::Vector2f size = m_nameToTextureData[owner].size;
+    TextureData* tex = AddTexture(name, textureID, size);
+    m_nameToSource[name] = source;
+    if (owner != name) {
+        m_logger.Info("Texture '{}' has the same pixels as '{}', sharing ID {}", name, owner, textureID);
+    }
     return tex;
 }
+
+void TextureManager::SetContentHash(GLuint textureID, uint64_t contentHash, int width, int height) {
+    Residency& residency = m_residency[textureID];
+    auto previous = m_contentToTexture.find(residency.contentHash);
+    if (previous != m_contentToTexture.end() && previous->second == textureID) {
+        m_contentToTexture.erase(previous);
+    }
+    // A reload can land on pixels another texture already has; that one keeps the entry
+    residency.contentHash = contentHash;
+    residency.contentWidth = width;
+    residency.contentHeight = height;
+    m_contentToTexture.try_emplace(contentHash, textureID);
+}
+
+/* ============================================================== */
+/* Residency                                                      */
+/* ============================================================== */
+void TextureManager::SetSource(GLuint textureID, Util::StringId source, const TextureLoadOptions& options) {
+    auto it = m_residency.find(textureID);
+    if (it != m_residency.end()) {
+        it->second.source = source;
+        it->second.options = options;
+    }
+    auto owner = m_textureToName.find(textureID);
+    if (owner != m_textureToName.end()) {
+        m_nameToSource[owner->second] = source;
+    }
+}
+
+void TextureManager::SetResidentBytes(GLuint textureID, size_t bytes) {
+    Residency& residency = m_residency[textureID];
+    if (residency.resident) {
+        m_residentBytes -= residency.bytes;
+        m_residentBytes += bytes;
+    }
+    residency.bytes = bytes;
+}
+
+size_t TextureManager::ReloadFile(const std::string& filePath) {
+    // Sources are interned normalized, a path nobody interned isn't loaded from
+    std::optional<Util::StringId> changed = FindName(std::filesystem::path(filePath).lexically_normal().generic_string());
+    if (!changed || changed->IsEmpty()) {
+        return 0;
+    }
+
+    // Names loaded from the file, by the texture they use now
+    std::unordered_map<GLuint, std::vector<Util::StringId>> users;
+    for (const auto& [name, source] : m_nameToSource) {
+        if (source == *changed) {
+            users[m_nameToTextureData.at(name).id].push_back(name);
+        }
+    }
+
+    size_t queued = 0;
+    std::string path(changed->View());
+    for (const auto& [id, names] : users) {
+        Residency& residency = m_residency[id];
+        if (residency.pack || residency.reloading) {
+            continue;
+        }
+
+        if (names.size() < residency.refCount) {
+            // Aliases from other files keep the pixels they have
+            for (Util::StringId name : names) {
+                QueueLoad(name, path, nullptr, 0, residency.options, id);
+                m_logger.Info("Reloading texture '{}' from '{}' apart from ID {}", name, path, id);
+            }
+            queued += names.size();
+            continue;
+        }
+
+        auto name = m_textureToName.find(id);
+        if (name == m_textureToName.end()) {
+            continue;
+        }
+        // Evicted ones pick the new file up when they're next used
+        if (residency.resident) {
+            residency.reloading = true;
+            QueueLoad(name->second, path, nullptr, id, residency.options);
+        }
+        m_logger.Info("Reloading texture '{}' from '{}'", name->second, path);
+        ++queued;
+    }
+    return queued;
+}
+
+void TextureManager::SetBudget(size_t bytes) {
+    m_budgetBytes = bytes;
+    m_logger.Info("Texture budget set to {} MiB", bytes / (1024 * 1024));
+}
+
+size_t TextureManager::GetBudget() const {
+    return m_budgetBytes;
+}
+
+void TextureManager::SetPinned(const std::string& name, bool pinned) {
+    std::optional<Util::StringId> id = FindName(name);
+    auto it = id ? m_nameToTextureData.find(*id) : m_nameToTextureData.end();
+    if (it == m_nameToTextureData.end()) {
+        throw Core::Exception("TextureManager::SetPinned: texture not found: " + name);
+    }
+    Residency& residency = m_residency[it->second.id];
+    residency.pinned = pinned;
+    if (pinned) {
+        MarkUsed(it->second.id);
+    }
+}
+
+void TextureManager::MarkUsed(GLuint textureID) {
+    auto it = m_residency.find(textureID);
+    if (it == m_residency.end()) {
+        return;
+    }
+
+    Residency& residency = it->second;
+    residency.lastUsed = m_frame;
+    if (residency.resident || residency.reloading || residency.source.IsEmpty()) {
+        return;
+    }
+
+    auto name = m_textureToName.find(textureID);
+    if (name == m_textureToName.end()) {
+        return;
+    }
+    ++m_reloads;
+    if (residency.pack) {
+        // Cooked data needs no decoding, bring it straight back
+        const Core::AssetPack::Entry* entry = residency.pack->Find(residency.source.GetHash());
+        StateCache::Get().BindTexture(textureID);
+        AllocateStorage(static_cast<int>(entry->width), static_cast<int>(entry->height), static_cast<int>(entry->mipCount));
+        UploadFromPack(textureID, *residency.pack, residency.source);
+        residency.resident = true;
+        m_residentBytes += residency.bytes;
+        return;
+    }
+    residency.reloading = true;
+    QueueLoad(name->second, std::string(residency.source.View()), nullptr, textureID, residency.options);
+}
+
+void TextureManager::MarkUsed(const CommandList& commands) {
+    GLuint last = 0;
+    for (const CommandList::Command& command : commands.GetCommands()) {
+        if (command.type == CommandList::CommandType::Sprites && command.range.texture != last) {
+            last = command.range.texture;
+            MarkUsed(last);
+        }
+    }
+}
+
+void TextureManager::Evict(GLuint textureID, Residency& residency) {
+    // Keep the name so recorded draws stay valid, they sample transparent until reloaded
+    static const Uint32 placeholder = 0;
+    StateCache& state = StateCache::Get();
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    state.BindTexture(textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &placeholder);
+
+    // AllocateStorage left MAX_LEVEL at the last mip; empty those levels too or
+    // the driver keeps them while the budget counts them as freed
+    GLint maxLevel = 0;
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+    for (GLint level = 1; level <= maxLevel; ++level) {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+    residency.resident = false;
+    m_residentBytes -= residency.bytes;
+    ++m_evictions;
+}
+
+void TextureManager::EnforceBudget() {
+    if (m_budgetBytes == 0 || m_residentBytes <= m_budgetBytes) {
+        return;
+    }
+
+    // Anything drawn this frame stays, even if that leaves us over budget
+    std::vector<std::pair<uint64_t, GLuint>> candidates;
+    for (const auto& [id, residency] : m_residency) {
+        if (residency.resident && !residency.pinned && !residency.source.IsEmpty() && residency.lastUsed < m_frame) {
+            candidates.emplace_back(residency.lastUsed, id);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    size_t evicted = 0;
+    for (const auto& [lastUsed, id] : candidates) {
+        if (m_residentBytes <= m_budgetBytes) {
+            break;
+        }
+        Evict(id, m_residency[id]);
+        ++evicted;
+    }
+    m_logger.Debug("Evicted {} textures, {} MiB resident", evicted, m_residentBytes / (1024 * 1024));
+}
+
+void TextureManager::PublishStats() {
+    TextureStats stats;
+    stats.textureCount = m_residency.size();
+    stats.residentBytes = m_residentBytes;
+    stats.budgetBytes = m_budgetBytes;
+    stats.evictions = m_evictions;
+    stats.reloads = m_reloads;
+    for (const auto& [id, residency] : m_residency) {
+        stats.aliasCount += residency.refCount - 1;
+        if (!residency.resident) {
+            continue;
+        }
+        ++stats.residentCount;
+        stats.dedupSavedBytes += static_cast<size_t>(residency.refCount - 1) * residency.bytes;
+        if (residency.pinned || residency.source.IsEmpty()) {
+            stats.pinnedBytes += residency.bytes;
+        }
+    }
+
+    std::lock_guard lock(m_loads->mutex);
+    m_loads->stats = stats;
+}
+
+TextureStats TextureManager::GetStats() const {
+    std::lock_guard lock(m_loads->mutex);
+    return m_loads->stats;
+}
+
+TextureData TextureManager::GetSnapshot(const TextureData& texture) const {
+    std::lock_guard lock(m_loads->mutex);
+    return texture;
+}
@@ -0,0 +1,213 @@
+#include <Renderer/UploadRing.hpp>
+#include <Renderer/GL.hpp>
+#include <Renderer/StateCache.hpp>
+#include <Core/Exceptions.hpp>
+#include <algorithm>
+#include <string>
+
+using namespace Renderer;
+
+namespace {
+    constexpr GLbitfield PersistentFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    constexpr GLuint64 FenceTimeoutNs = 100'000'000; // per wait, retried
+}
+
+UploadRing::UploadRing()
+    : m_persistent(GL::HasBufferStorage()), m_logger("UploadRing") {
+    for (Slot& slot : m_slots) {
+        Allocate(slot, DefaultSlotBytes);
+    }
+    m_logger.Debug("Created {} upload slots of {} KiB ({})", SlotCount, DefaultSlotBytes / 1024,
+        m_persistent ? "persistently mapped" : "mapped per upload");
+}
+
+UploadRing::~UploadRing() {
+    for (Slot& slot : m_slots) {
+        Destroy(slot);
+    }
+}
+
+/* ============================================================== */
+/* Slot storage                                                   */
+/* ============================================================== */
+void UploadRing::Allocate(Slot& slot, size_t bytes) {
+    Destroy(slot);
+
+    StateCache& state = StateCache::Get();
+    GL::GenBuffers(1, &slot.buffer);
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+    if (m_persistent) {
+        GL::BufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, PersistentFlags);
+        slot.mapped = static_cast<uint8_t*>(GL::MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), PersistentFlags));
+    }
+    else {
+        GL::BufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+    }
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (m_persistent && !slot.mapped) {
+        throw Core::Exception("UploadRing: failed to map a " + std::to_string(bytes) + " byte pixel buffer");
+    }
+    slot.capacity = bytes;
+    slot.state = SlotState::Free;
+}
+
+void UploadRing::Destroy(Slot& slot) {
+    if (slot.fence) {
+        GL::DeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+    if (slot.buffer != 0) {
+        // Deleting a buffer unmaps it
+        GL::DeleteBuffers(1, &slot.buffer);
+        StateCache::Get().OnBufferDeleted(slot.buffer);
+        slot.buffer = 0;
+    }
+    slot.mapped = nullptr;
+    slot.capacity = 0;
+    slot.state = SlotState::Free;
+}
+
+/* ============================================================== */
+/* Acquire / upload                                               */
+/* ============================================================== */
+int UploadRing::Acquire(size_t bytes, bool wait) {
+    while (true) {
+        Retire();
+
+        // Prefer a free slot that is already big enough, otherwise grow one
+        int chosen = NoSlot;
+        for (int i = 0; i < SlotCount; ++i) {
+            if (m_slots[i].state != SlotState::Free) {
+                continue;
+            }
+            if (m_slots[i].capacity >= bytes) {
+                chosen = i;
+                break;
+            }
+            if (chosen == NoSlot) {
+                chosen = i;
+            }
+        }
+
+        if (chosen != NoSlot) {
+            Slot& slot = m_slots[chosen];
+            if (slot.capacity < bytes) {
+                Allocate(slot, bytes);
+            }
+            if (!m_persistent) {
+                StateCache& state = StateCache::Get();
+                state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+                slot.mapped = static_cast<uint8_t*>(GL::MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0,
+                    static_cast<GLsizeiptr>(slot.capacity), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+                state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                if (!slot.mapped) {
+                    throw Core::Exception("UploadRing: failed to map pixel buffer");
+                }
+            }
+            slot.state = SlotState::Writing;
+            return chosen;
+        }
+
+        if (!wait || !WaitOldest()) {
+            return NoSlot;
+        }
+    }
+}
+
+uint8_t* UploadRing::GetPointer(int slot) const {
+    return m_slots[slot].mapped;
+}
+
+void UploadRing::Upload(int slotIndex, GLuint texture, int width, int height, int levels) {
+    Slot& slot = m_slots[slotIndex];
+    StateCache& state = StateCache::Get();
+
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+    if (!m_persistent) {
+        GL::UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        slot.mapped = nullptr;
+    }
+
+    // With a buffer bound to PIXEL_UNPACK the data pointer is an offset into it
+    state.BindTexture(texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    size_t offset = 0;
+    for (int level = 0; level < levels; ++level) {
+        int levelWidth = std::max(1, width >> level);
+        int levelHeight = std::max(1, height >> level);
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, levelWidth, levelHeight, GL_RGBA, GL_UNSIGNED_BYTE,
+            reinterpret_cast<const void*>(offset));
+        offset += static_cast<size_t>(levelWidth) * levelHeight * 4;
+    }
+    state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    slot.fence = GL::FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.sequence = ++m_sequence;
+    slot.state = SlotState::InFlight;
+}
+
+void UploadRing::Release(int slotIndex) {
+    Slot& slot = m_slots[slotIndex];
+    if (!m_persistent && slot.mapped) {
+        StateCache& state = StateCache::Get();
+        state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+        GL::UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        state.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        slot.mapped = nullptr;
+    }
+    slot.state = SlotState::Free;
+}
+
+/* ============================================================== */
+/* Fences                                                         */
+/* ============================================================== */
+void UploadRing::Retire() {
+    for (Slot& slot : m_slots) {
+        if (slot.state != SlotState::InFlight) {
+            continue;
+        }
+        GLenum result = GL::ClientWaitSync(slot.fence, 0, 0);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+            GL::DeleteSync(slot.fence);
+            slot.fence = nullptr;
+            slot.state = SlotState::Free;
+        }
+    }
+}
+
+bool UploadRing::WaitOldest() {
+    Slot* oldest = nullptr;
+    for (Slot& slot : m_slots) {
+        if (slot.state == SlotState::InFlight && (!oldest || slot.sequence < oldest->sequence)) {
+            oldest = &slot;
+        }
+    }
+    if (!oldest) {
+        return false; // everything is being written, waiting won't help
+    }
+
+    GLenum result = GL_TIMEOUT_EXPIRED;
+    while (result == GL_TIMEOUT_EXPIRED) {
+        result = GL::ClientWaitSync(oldest->fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeoutNs);
+    }
+    if (result == GL_WAIT_FAILED) {
+        m_logger.Error("Waiting on an upload fence failed");
+    }
+    GL::DeleteSync(oldest->fence);
+    oldest->fence = nullptr;
+    oldest->state = SlotState::Free;
+    return true;
+}
+
+bool UploadRing::IsPersistent() const {
+    return m_persistent;
+}
+
+size_t UploadRing::GetInFlightCount() const {
+    size_t count = 0;
+    for (const Slot& slot : m_slots) {
+        count += slot.state == SlotState::InFlight ? 1 : 0;
+    }
+    return count;
+}
@@ -1,5 +1,9 @@
 #include <Renderer/Window.hpp>
 #include <SDL3/SDL_opengl.h>
+#include <Renderer/GL.hpp>
+#include <Core/Input.hpp>
+#include <Core/InputPump.hpp>
+#include <Core/Latency.hpp>
 
 using namespace Renderer;
 
@@ -11,6 +15,15 @@ Window::Window(const std::string& title, Math::Vector2f size)
 
     m_logger.Info("Creating window: {} ({}, {})", title, static_cast<int>(size.x), static_cast<int>(size.y));
 
+    // Core profile only, no fixed-function fallback
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+#ifdef __APPLE__
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG);
+#endif
+    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+
     // Create SDL window
     m_window = SDL_CreateWindow(title.c_str(), static_cast<int>(size.x), static_cast<int>(size.y), SDL_WINDOW_OPENGL);
     if (!m_window) {
@@ -34,6 +47,13 @@ Window::Window(const std::string& title, Math::Vector2f size)
     else {
         m_logger.Debug("OpenGL context created successfully");
     }
+
+    if (!GL::Load()) {
+        SDL_GL_DestroyContext(m_glcontext);
+        SDL_DestroyWindow(m_window);
+        m_window = nullptr;
+        throw Core::WindowException("Failed to load OpenGL 3.3 core functions");
+    }
     UpdateFPS();
 }
 
@@ -56,21 +76,52 @@ SDL_GLContext Window::GetGLContext() const {
 }
 
 void Window::Poll() {
+    Core::LatencyTracker& latency = Core::LatencyTracker::Get();
+    m_events.clear();
+    Core::Input::BeginFrame();
+
+    // The pump already stamped its events for the latency tracker
+    if (m_inputPump) {
+        Core::InputEvent input;
+        while (m_inputPump->Pop(input)) {
+            Core::Input::HandleEvent(input.event);
+            m_events.push_back(input.event);
+            m_lastEvent = input.event;
+        }
+        m_quitRequested |= m_inputPump->IsQuitRequested();
+        return;
+    }
+
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
+        if (Core::LatencyTracker::IsTracked(event)) {
+            latency.OnPolled(event, SDL_GetTicksNS());
+        }
+        m_quitRequested |= event.type == SDL_EVENT_QUIT;
+        Core::Input::HandleEvent(event);
+        m_events.push_back(event);
         m_lastEvent = event;
     }
 }
 
+void Window::SetInputPump(Core::InputPump* pump) {
+    m_inputPump = pump;
+}
+
 SDL_Event Window::GetLastEvent() const {
     return m_lastEvent;
 }
 
+const std::vector<SDL_Event>& Window::GetEvents() const {
+    return m_events;
+}
+
 /* ============================================================== */
 /* High-level window API                                          */
 /* ============================================================== */
 bool Window::ShouldExit() {
-    return m_lastEvent.type == SDL_EVENT_QUIT;
+    // Any quit in the batch counts, not only a trailing one
+    return m_quitRequested;
 }
 
 bool Window::SetTitle(const std::string& title) {
@@ -85,7 +136,8 @@ bool Window::SetTitle(const std::string& title) {
 }
 
 void Window::UpdateFPS() {
-    uint64_t now = SDL_GetTicks();
+    // Nanoseconds: at paced high rates whole milliseconds make the delta jitter
+    uint64_t now = SDL_GetTicksNS();
     if (m_lastTime == 0) {
         m_lastTime = now;
         m_prevFrameTime = now;
@@ -94,7 +146,7 @@ void Window::UpdateFPS() {
         return;
     }
 
-    m_deltaTime = (now - m_prevFrameTime) / 1000.0f;
+    m_deltaTime = (now - m_prevFrameTime) / 1e9f;
     m_prevFrameTime = now;
 
     float currentFPS = (m_deltaTime > 0.0f) ? (1.0f / m_deltaTime) : 0.0f;
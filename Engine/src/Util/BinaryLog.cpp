@@ -0,0 +1,185 @@
+#include <Util/BinaryLog.hpp>
+#include <Core/Exceptions.hpp>
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+using namespace Util;
+using namespace Util::BinaryLogFormat;
+
+namespace {
+    constexpr size_t Padded(size_t size) {
+        return (size + RecordAlignment - 1) & ~(RecordAlignment - 1);
+    }
+}
+
+/* ============================================================== */
+/* File                                                           */
+/* ============================================================== */
+#ifdef _WIN32
+BinaryLog::BinaryLog(const std::string& path, size_t capacity)
+    : m_path(path), m_capacity(Padded(std::max(capacity, sizeof(Header) + 4096))),
+    m_sites(std::make_unique<std::atomic<uint64_t>[]>(SiteSlots)) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw Core::Exception("BinaryLog: failed to create '" + path + "'");
+    }
+
+    LARGE_INTEGER size{};
+    size.QuadPart = static_cast<LONGLONG>(m_capacity);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, size.HighPart, size.LowPart, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, m_capacity) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        throw Core::Exception("BinaryLog: failed to map '" + path + "'");
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<uint8_t*>(view);
+#else
+BinaryLog::BinaryLog(const std::string& path, size_t capacity)
+    : m_path(path), m_capacity(Padded(std::max(capacity, sizeof(Header) + 4096))),
+    m_sites(std::make_unique<std::atomic<uint64_t>[]>(SiteSlots)) {
+    m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+        throw Core::Exception("BinaryLog: failed to create '" + path + "': " + std::strerror(errno));
+    }
+
+    // Sparse until written, the unused tail is cut off again on close
+    void* view = MAP_FAILED;
+    if (ftruncate(m_fd, static_cast<off_t>(m_capacity)) == 0) {
+        view = mmap(nullptr, m_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    }
+    if (view == MAP_FAILED) {
+        int error = errno;
+        close(m_fd);
+        throw Core::Exception("BinaryLog: failed to map '" + path + "': " + std::strerror(error));
+    }
+
+    m_data = static_cast<uint8_t*>(view);
+#endif
+
+    using namespace std::chrono;
+    Header header{};
+    header.magic = Magic;
+    header.version = Version;
+    header.capacity = m_capacity;
+    header.steadyNs = SteadyNs();
+    header.wallClockNs = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+    std::memcpy(m_data, &header, sizeof(header));
+    m_writeOffset.store(sizeof(Header), std::memory_order_relaxed);
+}
+
+BinaryLog::~BinaryLog() {
+    uint64_t used = std::min<uint64_t>(m_writeOffset.load(std::memory_order_acquire), m_capacity);
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    LARGE_INTEGER end{};
+    end.QuadPart = static_cast<LONGLONG>(used);
+    if (SetFilePointerEx(static_cast<HANDLE>(m_file), end, nullptr, FILE_BEGIN)) {
+        SetEndOfFile(static_cast<HANDLE>(m_file));
+    }
+    CloseHandle(static_cast<HANDLE>(m_file));
+#else
+    munmap(m_data, m_capacity);
+    // Failing to trim only leaves zeroes at the end, which the decoder stops at
+    [[maybe_unused]] int trimmed = ftruncate(m_fd, static_cast<off_t>(used));
+    close(m_fd);
+#endif
+}
+
+/* ============================================================== */
+/* Records                                                        */
+/* ============================================================== */
+bool BinaryLog::IsNewSite(uint64_t site) {
+    size_t mask = SiteSlots - 1;
+    for (size_t probe = 0, slot = site & mask; probe < SiteSlots; ++probe, slot = (slot + 1) & mask) {
+        uint64_t seen = m_sites[slot].load(std::memory_order_relaxed);
+        if (seen == site) {
+            return false;
+        }
+        if (seen == 0) {
+            if (m_sites[slot].compare_exchange_strong(seen, site, std::memory_order_relaxed)) {
+                return true;
+            }
+            if (seen == site) {
+                return false;
+            }
+        }
+    }
+    // Thousands of sites: describe the rest every time rather than lose them
+    return true;
+}
+
+void BinaryLog::WriteSite(uint64_t site, const LogSite& info, const ArgType* types, size_t argCount, uint64_t timestampNs) {
+    SiteInfo header{};
+    header.level = info.level;
+    header.argCount = static_cast<uint8_t>(argCount);
+    header.scopeLength = static_cast<uint16_t>(std::min<size_t>(info.scope.size(), UINT16_MAX));
+    header.fileLength = static_cast<uint16_t>(std::min<size_t>(info.file.size(), UINT16_MAX));
+    header.line = info.line;
+    header.formatLength = static_cast<uint32_t>(info.format.size());
+
+    size_t size = sizeof(RecordHeader) + sizeof(SiteInfo) + argCount + header.scopeLength + header.fileLength + header.formatLength;
+    uint8_t* record = Reserve(size);
+    if (!record) {
+        return;
+    }
+
+    uint8_t* cursor = record + sizeof(RecordHeader);
+    std::memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+    std::copy_n(types, argCount, reinterpret_cast<ArgType*>(cursor));
+    cursor += argCount;
+    std::memcpy(cursor, info.scope.data(), header.scopeLength);
+    cursor += header.scopeLength;
+    std::memcpy(cursor, info.file.data(), header.fileLength);
+    cursor += header.fileLength;
+    std::memcpy(cursor, info.format.data(), header.formatLength);
+    Commit(record, size, RecordKind::Site, site, timestampNs);
+}
+
+uint8_t* BinaryLog::Reserve(size_t size) {
+    size = Padded(size);
+    uint64_t offset = m_writeOffset.fetch_add(size, std::memory_order_relaxed);
+    if (offset + size > m_capacity) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return m_data + offset;
+}
+
+void BinaryLog::Commit(uint8_t* record, size_t size, RecordKind kind, uint64_t site, uint64_t timestampNs) {
+    RecordHeader header{};
+    header.size = static_cast<uint32_t>(Padded(size));
+    header.kind = kind;
+    header.site = site;
+    header.timestampNs = timestampNs;
+    std::memcpy(record, &header, sizeof(header));
+}
+
+const std::string& BinaryLog::GetPath() const {
+    return m_path;
+}
+
+uint64_t BinaryLog::GetWrittenBytes() const {
+    return std::min<uint64_t>(m_writeOffset.load(std::memory_order_relaxed), m_capacity);
+}
+
+uint64_t BinaryLog::GetDroppedCount() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,161 @@
+#include <Util/StringInterner.hpp>
+#include <Util/Hash.hpp>
+#include <Core/Exceptions.hpp>
+#include <algorithm>
+#include <mutex>
+
+using namespace Util;
+
+/* ============================================================== */
+/* StringId                                                       */
+/* ============================================================== */
+std::string_view StringId::View() const {
+    return StringInterner::Get().View(*this);
+}
+
+const char* StringId::CStr() const {
+    return View().data();
+}
+
+uint64_t StringId::GetHash() const {
+    return StringInterner::Get().GetHash(*this);
+}
+
+/* ============================================================== */
+/* StringInterner                                                 */
+/* ============================================================== */
+StringInterner::StringInterner()
+    : m_slots(1024, 0) {
+    // ID 0 is the empty string, so a default StringId prints as one
+    m_chunks[0] = std::make_unique<Entry[]>(ChunkSize);
+    m_chunks[0][0] = Entry{ "", 0, Fnv1a(std::string_view()) };
+    m_count = 1;
+}
+
+StringInterner& StringInterner::Get() {
+    static StringInterner interner;
+    return interner;
+}
+
+StringId StringInterner::Intern(std::string_view text) {
+    uint64_t hash = Fnv1a(text);
+    {
+        std::shared_lock lock(m_mutex);
+        uint32_t id = m_slots[Probe(text, hash)];
+        if (id != 0 || text.empty()) {
+            return StringId(id);
+        }
+    }
+
+    std::unique_lock lock(m_mutex);
+    // Someone may have added it between the two locks
+    size_t slot = Probe(text, hash);
+    if (m_slots[slot] != 0) {
+        return StringId(m_slots[slot]);
+    }
+    if (m_count == ChunkSize * MaxChunks) {
+        throw Core::Exception("StringInterner: out of IDs");
+    }
+
+    uint32_t id = m_count;
+    std::unique_ptr<Entry[]>& chunk = m_chunks[id >> ChunkBits];
+    if (!chunk) {
+        chunk = std::make_unique<Entry[]>(ChunkSize);
+    }
+    chunk[id & (ChunkSize - 1)] = Entry{ Store(text), static_cast<uint32_t>(text.size()), hash };
+    ++m_count;
+
+    m_slots[slot] = id;
+    // Kept at most half full so probes stay short
+    if (m_count * 2 > m_slots.size()) {
+        Grow();
+    }
+    return StringId(id);
+}
+
+std::optional<StringId> StringInterner::Find(std::string_view text) const {
+    if (text.empty()) {
+        return StringId();
+    }
+
+    std::shared_lock lock(m_mutex);
+    uint32_t id = m_slots[Probe(text, Fnv1a(text))];
+    return id != 0 ? std::optional(StringId(id)) : std::nullopt;
+}
+
+std::string_view StringInterner::View(StringId id) const {
+    const Entry& entry = GetEntry(id.GetValue());
+    return std::string_view(entry.text, entry.length);
+}
+
+uint64_t StringInterner::GetHash(StringId id) const {
+    return GetEntry(id.GetValue()).hash;
+}
+
+size_t StringInterner::GetCount() const {
+    std::shared_lock lock(m_mutex);
+    return m_count;
+}
+
+size_t StringInterner::GetArenaBytes() const {
+    std::shared_lock lock(m_mutex);
+    return m_arenaBytes;
+}
+
+const StringInterner::Entry& StringInterner::GetEntry(uint32_t id) const {
+    return m_chunks[id >> ChunkBits][id & (ChunkSize - 1)];
+}
+
+size_t StringInterner::Probe(std::string_view text, uint64_t hash) const {
+    size_t mask = m_slots.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        uint32_t id = m_slots[slot];
+        if (id == 0) {
+            return slot;
+        }
+        const Entry& entry = GetEntry(id);
+        if (entry.hash == hash && std::string_view(entry.text, entry.length) == text) {
+            return slot;
+        }
+    }
+}
+
+const char* StringInterner::Store(std::string_view text) {
+    size_t size = text.size() + 1;
+    char* stored;
+    if (size > ArenaBlockSize / 4) {
+        // Long strings get a block of their own, kept in front of the open one
+        std::unique_ptr<char[]> block = std::make_unique<char[]>(size);
+        stored = block.get();
+        m_arena.insert(m_arena.empty() ? m_arena.end() : m_arena.end() - 1, std::move(block));
+    }
+    else {
+        if (size > ArenaBlockSize - m_arenaUsed) {
+            m_arena.push_back(std::make_unique<char[]>(ArenaBlockSize));
+            m_arenaUsed = 0;
+        }
+        stored = m_arena.back().get() + m_arenaUsed;
+        m_arenaUsed += size;
+    }
+
+    std::copy_n(text.data(), text.size(), stored);
+    stored[text.size()] = '\0';
+    m_arenaBytes += size;
+    return stored;
+}
+
+void StringInterner::Grow() {
+    std::vector<uint32_t> slots(m_slots.size() * 2, 0);
+    size_t mask = slots.size() - 1;
+    for (uint32_t id : m_slots) {
+        if (id == 0) {
+            continue;
+        }
+        size_t slot = GetEntry(id).hash & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+    m_slots = std::move(slots);
+}
@@ -1,13 +1,26 @@
+#include <algorithm>
 #include <iostream>
+#include <cstring>
+#include <exception>
+#include <thread>
 #include <Renderer/Renderer.hpp>
 #include <Renderer/Draw.hpp>
 #include <Renderer/TextureManager.hpp>
 #include <Util/Log.hpp>
 #include <Core/Exceptions.hpp>
+#include <Core/AssetPack.hpp>
+#include <Core/FileWatcher.hpp>
+#include <Core/FramePacer.hpp>
+#include <Core/InputPump.hpp>
+#include <Core/Latency.hpp>
 #include <SDL3/SDL_opengl.h>
 #include <Math/Vector.hpp>
 #include <SDL3/SDL.h>
 #include <Core/Input.hpp>
+#include <Physics/SpatialHash.hpp>
+#include <Renderer/Particles.hpp>
+#include <Renderer/SpriteBatch.hpp>
+#include <Renderer/RenderThread.hpp>
 
 // ImGui includes
 #include <imgui.h>
@@ -15,12 +28,30 @@
 #include <backends/imgui_impl_opengl3.h>
 
 namespace Game {
+    enum Action {
+        MoveUp,
+        MoveDown,
+        MoveLeft,
+        MoveRight,
+    };
+
     Util::Logger logger("MainGame");
     Renderer::Window* window = nullptr;
     SDL_Window* rawWindow = nullptr;
     Renderer::TextureManager* textureManager = nullptr;
+    Core::AssetPack* assetPack = nullptr;
+    Core::FileWatcher* fileWatcher = nullptr;
+    Core::FramePacer* framePacer = nullptr;
+    Core::InputPump* inputPump = nullptr;
+    Util::BinaryLog* binaryLog = nullptr;
     Math::Vector2f screenSize(900.0f, 700.0f);
     Renderer::TextureData* shrekTexture = nullptr;
+    Renderer::RenderThread* renderThread = nullptr;
+
+    // ImGui's view of the window while the input pump owns SDL, kept up to date
+    // from the pumped events
+    ImVec2 imguiWindowSize;
+    ImVec2 imguiPixelSize;
 }
 
 using namespace Game;
@@ -45,7 +76,20 @@ namespace {
         Renderer::Draw::Init(screenSize, false);
 
         textureManager = new Renderer::TextureManager();
-        shrekTexture = textureManager->AddTextureFromFile("shrek", "assets/shrek.png");
+        textureManager->SetBudget(256 * 1024 * 1024);
+
+        // Cooked assets when the pack is around (CookAssets target), loose files otherwise
+        uint64_t loadStart = SDL_GetTicksNS();
+        const char* packPath = "assets.pak";
+        if (SDL_GetPathInfo(packPath, nullptr)) {
+            assetPack = new Core::AssetPack(packPath);
+            shrekTexture = textureManager->AddTextureFromPack("shrek", *assetPack, "shrek.png");
+        }
+        else {
+            shrekTexture = textureManager->AddTextureFromFile("shrek", "assets/shrek.png");
+        }
+        logger.Info("Startup textures loaded in {:.2f} ms ({})", (SDL_GetTicksNS() - loadStart) / 1e6,
+            assetPack ? "pack" : "loose files");
 
         // ImGui initialization
         IMGUI_CHECKVERSION();
@@ -56,11 +100,61 @@ namespace {
 
         ImGui_ImplSDL3_InitForOpenGL(rawWindow, window->GetGLContext());
         ImGui_ImplOpenGL3_Init("#version 330 core");
+        ImGui_ImplOpenGL3_CreateDeviceObjects();
+
+        // GL setup is done, from here on the render thread owns the context
+        renderThread = new Renderer::RenderThread(*window);
+        // Edited assets reload in the background while the game runs. Charts have
+        // no loader yet, changes to them are only reported.
+        fileWatcher = new Core::FileWatcher();
+        fileWatcher->Watch("assets", [](const std::string& path) { textureManager->ReloadFile(path); });
+        if (SDL_GetPathInfo("songs", nullptr)) {
+            fileWatcher->Watch("songs", [](const std::string& path) { logger.Info("Chart changed: {}", path); });
+        }
+
+        renderThread->SetFrameCallback([](Renderer::CommandList& commands) {
+            fileWatcher->Poll();
+            textureManager->MarkUsed(commands);
+            textureManager->PumpUploads();
+        });
+        renderThread->Start();
+
+        // Vsync is off: pace to the display ourselves, sampling input as late as we can
+        framePacer = new Core::FramePacer(Core::FramePacer::GetRefreshRate(rawWindow), Core::FramePacer::Mode::JustInTime);
+
+        using Core::Input::BindingSource;
+        Core::Input::Bind(BindingSource::Key, SDL_SCANCODE_W, MoveUp);
+        Core::Input::Bind(BindingSource::Key, SDL_SCANCODE_S, MoveDown);
+        Core::Input::Bind(BindingSource::Key, SDL_SCANCODE_A, MoveLeft);
+        Core::Input::Bind(BindingSource::Key, SDL_SCANCODE_D, MoveRight);
+        Core::Input::Bind(BindingSource::GamepadButton, SDL_GAMEPAD_BUTTON_DPAD_UP, MoveUp);
+        Core::Input::Bind(BindingSource::GamepadButton, SDL_GAMEPAD_BUTTON_DPAD_DOWN, MoveDown);
+        Core::Input::Bind(BindingSource::GamepadButton, SDL_GAMEPAD_BUTTON_DPAD_LEFT, MoveLeft);
+        Core::Input::Bind(BindingSource::GamepadButton, SDL_GAMEPAD_BUTTON_DPAD_RIGHT, MoveRight);
 
         return true;
     }
 
     void Cleanup() {
+        Core::LatencyTracker::Get().LogSummary();
+        Util::Logger::FlushSuppressed();
+
+        if (window) {
+            window->SetInputPump(nullptr);
+        }
+        delete inputPump;
+        inputPump = nullptr;
+
+        // Stopping hands the GL context back for the teardown below
+        delete renderThread;
+        renderThread = nullptr;
+
+        delete fileWatcher;
+        fileWatcher = nullptr;
+
+        delete framePacer;
+        framePacer = nullptr;
+
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplSDL3_Shutdown();
         ImGui::DestroyContext();
@@ -68,28 +162,64 @@ namespace {
         delete textureManager;
         textureManager = nullptr;
 
+        delete assetPack;
+        assetPack = nullptr;
+
+        Renderer::Draw::Shutdown();
+
         delete window;
         window = nullptr;
 
         SDL_Quit();
+
+        if (binaryLog) {
+            Util::Logger::SetBinaryOutput(nullptr);
+            logger.Info("Binary log: {} bytes in '{}', {} messages dropped", binaryLog->GetWrittenBytes(),
+                binaryLog->GetPath(), binaryLog->GetDroppedCount());
+            delete binaryLog;
+            binaryLog = nullptr;
+        }
     }
 
     /* ============================================================== */
     /* MAIN GAME LOGIC                                                */
     /* ============================================================== */
-    bool IsMouseOnTexture(const Math::Vector2f& mousePos, const Math::Vector2f& texPos, const Math::Vector2f& texSize) {
-        float halfWidth = texSize.x / 2.0f;
-        float halfHeight = texSize.y / 2.0f;
-
-        return mousePos.x >= (texPos.x - halfWidth) &&
-            mousePos.x <= (texPos.x + halfWidth) &&
-            mousePos.y >= (texPos.y - halfHeight) &&
-            mousePos.y <= (texPos.y + halfHeight);
+    // Stands in for ImGui_ImplSDL3_NewFrame while the input pump runs. That one
+    // captures and warps the mouse and sets the OS cursor, which must not happen
+    // off the main thread, so the OS cursor stays as it is in this mode.
+    void TrackImGuiWindow(const SDL_Event& e) {
+        switch (e.type) {
+        case SDL_EVENT_WINDOW_RESIZED:
+            Game::imguiWindowSize = ImVec2(static_cast<float>(e.window.data1), static_cast<float>(e.window.data2));
+            break;
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+            Game::imguiPixelSize = ImVec2(static_cast<float>(e.window.data1), static_cast<float>(e.window.data2));
+            break;
+        case SDL_EVENT_WINDOW_MOUSE_LEAVE:
+            ImGui::GetIO().AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void NewImGuiFrameFromEvents() {
+        ImGuiIO& io = ImGui::GetIO();
+        ImVec2 size = Game::imguiWindowSize;
+        io.DisplaySize = size;
+        io.DisplayFramebufferScale = size.x > 0 && size.y > 0
+            ? ImVec2(Game::imguiPixelSize.x / size.x, Game::imguiPixelSize.y / size.y) : ImVec2(1.0f, 1.0f);
+        io.DeltaTime = std::max(Game::window->GetDeltaTime(), 1e-4f);
     }
 
     void RenderImGui() {
         ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplSDL3_NewFrame();
+        if (Game::inputPump) {
+            NewImGuiFrameFromEvents();
+        }
+        else {
+            ImGui_ImplSDL3_NewFrame();
+        }
         ImGui::NewFrame();
 
         bool show_window = false;
@@ -97,6 +227,72 @@ namespace {
 		ImGui::Text("FPS: %.1f", Game::window->GetFPS());
 		ImGui::Text("Mouse Position: (%.1f, %.1f)", Core::Input::GetMousePosition().x, Core::Input::GetMousePosition().y);
 		ImGui::Text("Keyboard Input (Pressed): %s", SDL_GetScancodeName(Core::Input::GetKeyPressed()));
+        Renderer::RenderThread::Stats renderStats = Game::renderThread->GetStats();
+        ImGui::Text("Render: %.2f ms, %llu presented, %llu dropped", renderStats.renderMs,
+            static_cast<unsigned long long>(renderStats.presented), static_cast<unsigned long long>(renderStats.dropped));
+        const Core::FramePacer::Stats& pacing = Game::framePacer->GetStats();
+        int pacingMode = static_cast<int>(Game::framePacer->GetMode());
+        if (ImGui::Combo("Pacing", &pacingMode, "Unlimited\0Limit\0Just in time\0")) {
+            Game::framePacer->SetMode(static_cast<Core::FramePacer::Mode>(pacingMode));
+        }
+        ImGui::Text("Pacing: %.1f Hz, work %.2f ms (budget %.2f), wait %.2f ms (%.2f spin), %llu late",
+            pacing.targetHz, pacing.workMs, pacing.estimateMs, pacing.waitMs, pacing.spinMs,
+            static_cast<unsigned long long>(pacing.late));
+        ImGui::Text("Draw calls: %u", renderStats.drawCalls);
+        ImGui::Text("GL state calls: %u issued, %u skipped", renderStats.glIssued, renderStats.glSkipped);
+        Renderer::TextureStats textureStats = Game::textureManager->GetStats();
+        ImGui::Text("Textures: %zu (%zu resident), %.1f / %.1f MiB, %.1f MiB pinned", textureStats.textureCount,
+            textureStats.residentCount, textureStats.residentBytes / (1024.0f * 1024.0f),
+            textureStats.budgetBytes / (1024.0f * 1024.0f), textureStats.pinnedBytes / (1024.0f * 1024.0f));
+        ImGui::Text("Texture evictions: %llu, reloads: %llu", static_cast<unsigned long long>(textureStats.evictions),
+            static_cast<unsigned long long>(textureStats.reloads));
+        ImGui::Text("Shared textures: %zu names, %.1f MiB saved", textureStats.aliasCount,
+            textureStats.dedupSavedBytes / (1024.0f * 1024.0f));
+
+        if (ImGui::CollapsingHeader("Input latency")) {
+            Core::LatencyTracker& latency = Core::LatencyTracker::Get();
+            Core::LatencyTracker::Histograms histograms = latency.GetHistograms();
+            for (int stage = 0; stage < Core::LatencyTracker::StageCount; ++stage) {
+                const Core::LatencyHistogram& histogram = histograms[stage];
+                ImGui::Text("%-8s p50 %5.2f  p99 %5.2f  max %5.2f ms",
+                    Core::LatencyTracker::GetStageName(static_cast<Core::LatencyTracker::Stage>(stage)),
+                    histogram.GetPercentileMs(0.5), histogram.GetPercentileMs(0.99), histogram.GetMaxMs());
+            }
+
+            // Event to photon, 0.25 ms per bar
+            const Core::LatencyHistogram& total = histograms[Core::LatencyTracker::Total];
+            static std::array<float, Core::LatencyHistogram::BucketCount> bars;
+            for (size_t i = 0; i < bars.size(); ++i) {
+                bars[i] = static_cast<float>(total.GetBuckets()[i]);
+            }
+            ImGui::PlotHistogram("##total", bars.data(), static_cast<int>(bars.size()), 0, nullptr, 0.0f, FLT_MAX,
+                ImVec2(0.0f, 60.0f));
+            if (ImGui::Button("Log")) {
+                latency.LogSummary();
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Reset")) {
+                latency.Reset();
+            }
+        }
+
+        if (ImGui::CollapsingHeader("Controllers")) {
+            std::vector<Core::Input::DeviceStats> devices = Core::Input::GetDeviceStats();
+            if (devices.empty()) {
+                ImGui::TextDisabled("None connected");
+            }
+            for (const Core::Input::DeviceStats& device : devices) {
+                ImGui::Text("%s%s (%s)", device.name.c_str(), device.isVirtual ? " [virtual]" : "",
+                    device.gamepad ? "gamepad" : "joystick");
+                if (device.rateHz > 0.0) {
+                    ImGui::Text("  %.0f Hz, jitter %.3f ms, %llu reports", device.rateHz, device.jitterMs,
+                        static_cast<unsigned long long>(device.reports));
+                }
+                else {
+                    ImGui::TextDisabled("  Move a stick to measure polling");
+                }
+            }
+        }
         ImGui::End();
 	}
 
@@ -108,19 +304,49 @@ namespace {
         Math::Vector2f texturePos(Game::screenSize.x / 2, Game::screenSize.y / 2);
         bool wasLeftButtonDown = false;
 
+        // The render thread rewrites the texture when its file is reloaded, read copies of it here
+        Renderer::TextureData shrek = Game::textureManager->GetSnapshot(*Game::shrekTexture);
+
+        // Mouse picking goes through the spatial hash
+        Physics::SpatialHash pickGrid(128.0f);
+        Physics::BodyID shrekBody = pickGrid.Insert(Physics::AABB::FromCenter(texturePos, shrek.size));
+
+        // Click effects
+        Renderer::EmitterSettings burstSettings;
+        burstSettings.texture = shrek.id;
+        burstSettings.size = Math::Vector2f(12.0f, 12.0f);
+        burstSettings.gravity = Math::Vector2f(0.0f, 600.0f);
+        burstSettings.drag = 1.5f;
+        Renderer::ParticleEmitter clickBurst(8192, burstSettings);
+        Renderer::SpriteBatch effectBatch;
+
+        // Particles draw over the sprite
+        Renderer::DrawParams effectParams;
+        effectParams.depth = 1;
+
         const float moveSpeed = 300.0f; // pixels per second
 
         while (!Game::window->ShouldExit()) {
+            // Just-in-time pacing waits here, before any input is read
+            Game::framePacer->BeginFrame();
+
             // Poll events
             Game::window->Poll();
 
             // Feed events to ImGui
-            SDL_Event e = Game::window->GetLastEvent();
-            ImGui_ImplSDL3_ProcessEvent(&e);
+            for (const SDL_Event& e : Game::window->GetEvents()) {
+                ImGui_ImplSDL3_ProcessEvent(&e);
+                if (Game::inputPump) {
+                    TrackImGuiWindow(e);
+                }
+            }
 
             // Update FPS
             Game::window->UpdateFPS();
-			Game::window->SetTitle("Game - FPS: " + std::to_string(static_cast<int>(Game::window->GetFPS() + 0.5f)));
+            // Window changes belong to the main thread, which the input pump may have
+            if (!Game::inputPump) {
+                Game::window->SetTitle("Game - FPS: " + std::to_string(static_cast<int>(Game::window->GetFPS() + 0.5f)));
+            }
             float deltaTime = Game::window->GetDeltaTime();
 
             // Render ImGui frame
@@ -130,7 +356,8 @@ namespace {
             mousePos = Core::Input::GetMousePosition();
             bool isLeftDown = Core::Input::IsButtonDown(SDL_BUTTON_LEFT);
             if (isLeftDown && !wasLeftButtonDown) {
-                if (IsMouseOnTexture(mousePos, texturePos, Game::shrekTexture->size)) {
+                clickBurst.Burst(mousePos, 200);
+                if (pickGrid.Pick(mousePos) == shrekBody) {
                     dragging = true;
                     dragOffset = mousePos - texturePos;
                 }
@@ -145,29 +372,32 @@ namespace {
                 texturePos = mousePos - dragOffset;
             }
 
-            // WASD keyboard movement
-            if (Core::Input::IsKeyDown(SDL_SCANCODE_W)) {
+            // WASD or D-pad movement, held inputs keep moving between repeats
+            if (Core::Input::IsActionDown(Game::MoveUp)) {
                 texturePos.y -= moveSpeed * deltaTime;
             }
-            if (Core::Input::IsKeyDown(SDL_SCANCODE_S)) {
+            if (Core::Input::IsActionDown(Game::MoveDown)) {
                 texturePos.y += moveSpeed * deltaTime;
             }
-            if (Core::Input::IsKeyDown(SDL_SCANCODE_A)) {
+            if (Core::Input::IsActionDown(Game::MoveLeft)) {
                 texturePos.x -= moveSpeed * deltaTime;
             }
-            if (Core::Input::IsKeyDown(SDL_SCANCODE_D)) {
+            if (Core::Input::IsActionDown(Game::MoveRight)) {
                 texturePos.x += moveSpeed * deltaTime;
             }
 
             // Handle ESC key to exit
-            if (Core::Input::IsKeyDown(SDL_SCANCODE_ESCAPE)) {
-                Game::window->Poll();
+            if (Core::Input::WasPressed(SDL_SCANCODE_ESCAPE)) {
                 break;
             }
 
+            // Input for this frame has been acted on
+            Core::LatencyTracker::Get().OnConsumed();
+
             // Clamp texture position to screen bounds
-            float halfWidth = Game::shrekTexture->size.x / 2.0f;
-            float halfHeight = Game::shrekTexture->size.y / 2.0f;
+            shrek = Game::textureManager->GetSnapshot(*Game::shrekTexture);
+            float halfWidth = shrek.size.x / 2.0f;
+            float halfHeight = shrek.size.y / 2.0f;
             if (texturePos.x < halfWidth) {
                 texturePos.x = halfWidth;
             }
@@ -180,23 +410,87 @@ namespace {
             if (texturePos.y > Game::screenSize.y - halfHeight) {
                 texturePos.y = Game::screenSize.y - halfHeight;
             }
+            pickGrid.Update(shrekBody, Physics::AABB::FromCenter(texturePos, shrek.size));
+            clickBurst.Update(deltaTime);
+
+            // Record the frame, the render thread replays it
+            Renderer::CommandList& commands = Game::renderThread->BeginFrame();
+            commands.Clear(Math::Vector4f(1.0f, 1.0f, 1.0f, 1.0f));
+            commands.TexturedQuad(shrek.id, shrek.size, texturePos);
 
-            // Render
-            Renderer::Draw::Clear(Math::Vector4f(1.0f, 1.0f, 1.0f, 1.0f));
-            Renderer::Draw::TexturedQuad(Game::shrekTexture->id, Game::shrekTexture->size, texturePos);
+            effectBatch.Clear();
+            clickBurst.Emit(effectBatch);
+            commands.Sprites(effectBatch, effectParams);
 
             // ImGui render
             ImGui::Render();
-            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-            
-			// Finish the rendering
-            Renderer::Render(Game::window);
+            Game::renderThread->Submit(ImGui::GetDrawData());
+            Game::framePacer->EndFrame();
+        }
+    }
+
+    // Main thread pumps input as it arrives, the game loop runs on its own thread
+    void RunWithInputThread() {
+        int width = 0;
+        int height = 0;
+        SDL_GetWindowSize(rawWindow, &width, &height);
+        imguiWindowSize = ImVec2(static_cast<float>(width), static_cast<float>(height));
+        SDL_GetWindowSizeInPixels(rawWindow, &width, &height);
+        imguiPixelSize = ImVec2(static_cast<float>(width), static_cast<float>(height));
+
+        inputPump = new Core::InputPump();
+        window->SetInputPump(inputPump);
+
+        std::exception_ptr gameError;
+        std::thread gameThread([&gameError] {
+            try {
+                MainLoop();
+            }
+            catch (...) {
+                gameError = std::current_exception();
+            }
+            inputPump->Stop();
+        });
+        inputPump->Run();
+        gameThread.join();
+
+        if (gameError) {
+            std::rethrow_exception(gameError);
         }
     }
 }
 
 int main(int argc, char* argv[]) {
+    // Off by default: Core::Input still reads the mouse and opens controllers from
+    // the game thread, which SDL allows on X11 and Wayland
+    bool inputThread = false;
+    const char* binaryLogPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--input-thread") == 0) {
+            inputThread = true;
+        }
+        else if (std::strcmp(argv[i], "--binary-log") == 0 && i + 1 < argc) {
+            binaryLogPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--log-level") == 0 && i + 1 < argc) {
+            // <scope>=<level>, e.g. --log-level TextureManager=debug
+            std::string_view setting = argv[++i];
+            size_t equals = setting.find('=');
+            Util::Logger::Level level;
+            if (equals == std::string_view::npos || !Util::Logger::ParseLevel(setting.substr(equals + 1), level) ||
+                !Util::Logger::SetScopeLevel(setting.substr(0, equals), level)) {
+                logger.Warn("Ignoring --log-level '{}'", setting);
+            }
+        }
+    }
+
     try {
+        // Raw records instead of text, Tools/LogDecoder turns them back
+        if (binaryLogPath) {
+            binaryLog = new Util::BinaryLog(binaryLogPath);
+            Util::Logger::SetBinaryOutput(binaryLog);
+        }
+
         if (!Initialize()) {
             return -1;
         }
@@ -206,7 +500,12 @@ int main(int argc, char* argv[]) {
         logger.Info("Left click and drag to move the texture around");
         logger.Info("Press ESC to exit");
         logger.Info("--------------------");
-        MainLoop();
+        if (inputThread) {
+            RunWithInputThread();
+        }
+        else {
+            MainLoop();
+        }
         Cleanup();
     }
     catch (const Core::WindowException& e) {
@@ -0,0 +1,168 @@
+#include "Harness.hpp"
+#include <Core/AssetPack.hpp>
+#include <Renderer/TextureManager.hpp>
+#include <SDL3/SDL.h>
+#if _WIN32
+#include <SDL3/SDL_image.h>
+#else
+#include <SDL3_image/SDL_image.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace Renderer;
+
+namespace {
+    constexpr int TextureCount = 24;
+    constexpr int TextureSize = 512;
+    constexpr size_t Runs = 10;
+
+    // A skin's worth of sprite sheets as PNGs: gradients with some noise, so
+    // zlib has real work to do
+    fs::path WriteSkin() {
+        fs::path directory = fs::temp_directory_path() / "EngineBench_skin";
+        fs::remove_all(directory);
+        fs::create_directories(directory);
+
+        SDL_Surface* surface = SDL_CreateSurface(TextureSize, TextureSize, SDL_PIXELFORMAT_ABGR8888);
+        CHECK(surface != nullptr);
+        Uint32 seed = 1234;
+        for (int i = 0; i < TextureCount; ++i) {
+            for (int y = 0; y < TextureSize; ++y) {
+                Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch);
+                for (int x = 0; x < TextureSize; ++x) {
+                    seed = seed * 1664525u + 1013904223u;
+                    row[x] = 0xFF000000u | static_cast<Uint32>((x + i * 8) & 0xFF) << 16 | static_cast<Uint32>(y & 0xFF) << 8 | (seed >> 28);
+                }
+            }
+            bool saved = IMG_SavePNG(surface, (directory / std::format("sheet{:02}.png", i)).string().c_str());
+            CHECK(saved);
+        }
+        SDL_DestroySurface(surface);
+        return directory;
+    }
+
+    // Without mips, so both paths upload the same texels
+    fs::path CookSkin(const fs::path& directory) {
+        fs::path pack = fs::temp_directory_path() / "EngineBench_skin.pak";
+        std::string command = std::format("\"{}\" \"{}\" \"{}\" --no-mips", ASSET_COOKER_PATH, directory.string(), pack.string());
+        CHECK(std::system(command.c_str()) == 0);
+        return pack;
+    }
+
+    // Pushes a file out of the page cache so the next read goes to the disk.
+    // Only Linux (and other POSIX systems with fadvise) can do it unprivileged.
+    bool DropFromCache(const fs::path& path) {
+#if defined(POSIX_FADV_DONTNEED)
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            return false;
+        }
+        // Dirty pages aren't dropped, the freshly written files need a sync first
+        bool dropped = fdatasync(file) == 0 && posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        close(file);
+        return dropped;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    bool DropAllFromCache(const std::vector<fs::path>& paths) {
+        bool dropped = true;
+        for (const fs::path& path : paths) {
+            dropped = DropFromCache(path) && dropped;
+        }
+        return dropped;
+    }
+}
+
+// Startup texture loading as Game does it, from loose PNGs and from a cooked
+// pack, with the files' pages cached (warm) and dropped before each run (cold)
+BENCHMARK(AssetStartup) {
+    if (!Harness::RequireGL()) {
+        return;
+    }
+    fs::path directory = WriteSkin();
+    fs::path packPath = CookSkin(directory);
+
+    std::vector<fs::path> files;
+    std::vector<std::string> names;
+    for (int i = 0; i < TextureCount; ++i) {
+        names.push_back(std::format("sheet{:02}.png", i));
+        files.push_back(directory / names.back());
+    }
+    uintmax_t looseBytes = 0;
+    for (const fs::path& file : files) {
+        looseBytes += fs::file_size(file);
+    }
+    Harness::Note(std::format("{} textures of {}x{}: {} KiB of PNGs, {} KiB packed", TextureCount, TextureSize, TextureSize,
+        looseBytes / 1024, fs::file_size(packPath) / 1024));
+
+    bool canDrop = DropFromCache(packPath) && DropAllFromCache(files);
+    if (!canDrop) {
+        Harness::Note("can't drop files from the page cache here, cold runs skipped");
+    }
+
+    for (bool cold : { false, true }) {
+        if (cold && !canDrop) {
+            break;
+        }
+        const char* temperature = cold ? "cold" : "warm";
+
+        {
+            TextureManager textures;
+            Harness::Timing timing = Harness::Measure(Runs, [&] {
+                for (const std::string& name : names) {
+                    if (textures.FindSizeByName(name)) {
+                        textures.RemoveTextureByName(name);
+                    }
+                }
+                glFinish();
+                if (cold) {
+                    DropAllFromCache(files);
+                }
+            }, [&] {
+                for (size_t i = 0; i < names.size(); ++i) {
+                    textures.AddTextureFromFile(names[i], files[i].string());
+                }
+                glFinish();
+            });
+            Harness::Report(std::format("loose PNGs, {}", temperature), timing, TextureCount);
+        }
+
+        // Declared first so it outlives the textures read from it
+        std::unique_ptr<Core::AssetPack> pack;
+        TextureManager textures;
+        Harness::Timing timing = Harness::Measure(Runs, [&] {
+            // Textures first, they may reload from the pack while it is open
+            for (const std::string& name : names) {
+                if (textures.FindSizeByName(name)) {
+                    textures.RemoveTextureByName(name);
+                }
+            }
+            glFinish();
+            pack.reset();
+            if (cold) {
+                DropFromCache(packPath);
+            }
+        }, [&] {
+            pack = std::make_unique<Core::AssetPack>(packPath.string());
+            for (const std::string& name : names) {
+                textures.AddTextureFromPack(name, *pack, name);
+            }
+            glFinish();
+        });
+        Harness::Report(std::format("cooked pack, {}", temperature), timing, TextureCount);
+    }
+
+    fs::remove_all(directory);
+    fs::remove(packPath);
+}
@@ -0,0 +1,104 @@
+#include "Harness.hpp"
+#include <Renderer/CommandList.hpp>
+#include <algorithm>
+#include <format>
+#include <random>
+#include <vector>
+
+using namespace Renderer;
+
+namespace {
+    constexpr size_t CommandCount = 100'000;
+    constexpr size_t Runs = 50;
+
+    // Skin-heavy frame: notes and effects spread over a few layers and a few
+    // dozen textures, recorded in the interleaved order gameplay produces
+    void RecordScene(CommandList& list) {
+        std::mt19937 random(1234);
+        list.Reset();
+        list.Clear(Math::Vector4f(0.0f, 0.0f, 0.0f, 1.0f));
+        for (size_t i = 0; i < CommandCount; ++i) {
+            DrawParams params;
+            params.layer = static_cast<uint8_t>(random() % 4);
+            params.translucent = random() % 2 == 0;
+            params.depth = random() % 8;
+            GLuint texture = 1 + random() % 32;
+            list.TexturedQuad(texture, Math::Vector2f(32.0f, 32.0f), Math::Vector2f(static_cast<float>(i % 1280), 0.0f), params);
+        }
+    }
+
+    // The keys RecordScene produces, in call order
+    std::vector<uint64_t> MakeKeys() {
+        std::vector<uint64_t> keys(CommandCount);
+        std::mt19937 random(1234);
+        for (uint64_t& key : keys) {
+            DrawParams params;
+            params.layer = static_cast<uint8_t>(random() % 4);
+            params.translucent = random() % 2 == 0;
+            params.depth = random() % 8;
+            key = CommandList::MakeSortKey(params, 1 + random() % 32);
+        }
+        return keys;
+    }
+
+    // Ascending keys, call order among equal ones
+    bool IsStableOrder(const std::vector<uint64_t>& keys, const std::vector<uint32_t>& order) {
+        for (size_t i = 1; i < order.size(); ++i) {
+            uint64_t previous = keys[order[i - 1]];
+            uint64_t current = keys[order[i]];
+            if (previous > current || (previous == current && order[i - 1] > order[i])) {
+                return false;
+            }
+        }
+        return order.size() == keys.size();
+    }
+
+    // Draws replaying in call order would take, merging equal neighbours only
+    size_t CountUnsortedDraws(const CommandList& list) {
+        size_t draws = 0;
+        const CommandList::Command* last = nullptr;
+        for (const CommandList::Command& command : list.GetCommands()) {
+            if (command.type != CommandList::CommandType::Sprites) {
+                continue;
+            }
+            if (!last || last->range.texture != command.range.texture || last->shader != command.shader ||
+                last->translucent != command.translucent) {
+                ++draws;
+            }
+            last = &command;
+        }
+        return draws;
+    }
+}
+
+BENCHMARK(CommandListSort100k) {
+    CommandList list(CommandCount);
+    Harness::Timing timing = Harness::Measure(Runs, [&] { RecordScene(list); }, [&] { list.Sort(); });
+    Harness::Report("Sort + build calls, 100k commands", timing, CommandCount);
+
+    size_t unsorted = CountUnsortedDraws(list);
+    size_t sorted = list.GetDrawCallCount();
+    CHECK(sorted < unsorted);
+    Harness::Note(std::format("draw calls: {} in call order, {} sorted, {} spans", unsorted, sorted, list.GetSpans().size()));
+}
+
+// The key sort on its own, and the same keys through std::stable_sort for scale
+BENCHMARK(CommandListKeySort100k) {
+    std::vector<uint64_t> keys = MakeKeys();
+    std::vector<uint32_t> order;
+    CommandList::SortScratch scratch;
+
+    Harness::Timing timing = Harness::Measure(Runs, [&] { CommandList::SortKeys(keys, order, scratch); });
+    CHECK(IsStableOrder(keys, order));
+    Harness::Report("CommandList::SortKeys, 100k", timing, CommandCount);
+
+    timing = Harness::Measure(Runs, [&] {
+        for (uint32_t i = 0; i < CommandCount; ++i) {
+            order[i] = i;
+        }
+    }, [&] {
+        std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+    });
+    CHECK(IsStableOrder(keys, order));
+    Harness::Report("std::stable_sort of the keys, 100k", timing, CommandCount);
+}
@@ -0,0 +1,91 @@
+#include "Harness.hpp"
+#include <Renderer/CommandList.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace Renderer;
+
+namespace {
+    // What SortKeys must match: indices by key, call order among equal keys
+    std::vector<uint32_t> ReferenceOrder(const std::vector<uint64_t>& keys) {
+        std::vector<uint32_t> order(keys.size());
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+        return order;
+    }
+
+    std::vector<uint64_t> RandomKeys(size_t count, uint64_t mask, uint32_t seed) {
+        std::mt19937_64 random(seed);
+        std::vector<uint64_t> keys(count);
+        for (uint64_t& key : keys) {
+            key = random() & mask;
+        }
+        return keys;
+    }
+}
+
+// Packed digits, merged bit runs and the comparison fallback all agree with
+// std::stable_sort
+TEST_CASE(CommandListSortKeys) {
+    std::vector<uint32_t> order;
+    CommandList::SortScratch scratch;
+
+    std::vector<std::vector<uint64_t>> cases = {
+        {},
+        { 42 },
+        std::vector<uint64_t>(100, 7),
+        RandomKeys(5000, 0x0300'0000'0000'0007ull, 1),    // two runs, one pass
+        RandomKeys(5000, 0x0380'0007'1F80'003Full, 2),    // four runs, two passes
+        RandomKeys(5000, 0x0000'0000'0055'5555ull, 3),    // 12 runs merged down to four
+        RandomKeys(5000, 0x0000'00FF'FFFF'FFFFull, 4),    // 40 varying bits, comparison sort
+        RandomKeys(100'000, 0x0FFF'0000'00FF'F000ull, 5), // three passes
+    };
+    for (const std::vector<uint64_t>& keys : cases) {
+        CommandList::SortKeys(keys, order, scratch);
+        CHECK(order == ReferenceOrder(keys));
+    }
+}
+
+// Two overlapping translucent sprites at the default depth replay in the order
+// they were recorded, whatever their texture IDs, and a higher depth still
+// draws on top
+TEST_CASE(CommandListTranslucentOrder) {
+    constexpr GLuint Back = 7;
+    constexpr GLuint Front = 3;
+    constexpr GLuint Top = 5;
+
+    CommandList list;
+    list.Clear(Math::Vector4f(0.0f, 0.0f, 0.0f, 1.0f));
+    DrawParams over;
+    over.depth = 1;
+    list.TexturedQuad(Top, Math::Vector2f(16.0f, 16.0f), Math::Vector2f(12.0f, 12.0f), over);
+    list.TexturedQuad(Back, Math::Vector2f(16.0f, 16.0f), Math::Vector2f(8.0f, 8.0f));
+    list.TexturedQuad(Front, Math::Vector2f(16.0f, 16.0f), Math::Vector2f(12.0f, 12.0f));
+    list.TexturedQuad(Back, Math::Vector2f(16.0f, 16.0f), Math::Vector2f(16.0f, 16.0f));
+
+    // Opaque draws go first and still merge by texture
+    DrawParams opaque;
+    opaque.translucent = false;
+    list.TexturedQuad(Back, Math::Vector2f(16.0f, 16.0f), Math::Vector2f(8.0f, 8.0f), opaque);
+    list.TexturedQuad(Front, Math::Vector2f(16.0f, 16.0f), Math::Vector2f(8.0f, 8.0f), opaque);
+    list.TexturedQuad(Back, Math::Vector2f(16.0f, 16.0f), Math::Vector2f(8.0f, 8.0f), opaque);
+    list.Sort();
+
+    const std::vector<CommandList::Call>& calls = list.GetCalls();
+    std::vector<GLuint> textures;
+    for (const CommandList::Call& call : calls) {
+        if (call.type == CommandList::CommandType::Sprites) {
+            textures.push_back(call.texture);
+        }
+    }
+    CHECK(calls.front().type == CommandList::CommandType::Clear);
+    CHECK((textures == std::vector<GLuint>{ Front, Back, Back, Front, Back, Top }));
+    CHECK(!calls[1].translucent && !calls[2].translucent);
+    CHECK(calls[2].spanCount == 2);
+    CHECK(calls[3].translucent && calls[3].spanCount == 1);
+    CHECK(list.GetDrawCallCount() == 6);
+}
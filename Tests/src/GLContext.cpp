@@ -0,0 +1,28 @@
+#include "Harness.hpp"
+#include <Core/Exceptions.hpp>
+#include <Renderer/Draw.hpp>
+#include <Renderer/Renderer.hpp>
+#include <Renderer/Window.hpp>
+#include <memory>
+
+bool Harness::RequireGL() {
+    static std::unique_ptr<Renderer::Window> window;
+    static bool tried = false;
+    if (tried) {
+        return window != nullptr;
+    }
+    tried = true;
+
+    try {
+        if (!Renderer::InitSDL()) {
+            throw Core::Exception("SDL video did not initialize");
+        }
+        window = std::make_unique<Renderer::Window>("EngineBench", Math::Vector2f(64.0f, 64.0f));
+        Renderer::Draw::Init(Math::Vector2f(64.0f, 64.0f), false);
+    }
+    catch (const Core::Exception& e) {
+        window.reset();
+        Note(std::string("skipped, no GL context: ") + e.what());
+    }
+    return window != nullptr;
+}
@@ -0,0 +1,80 @@
+#include "Harness.hpp"
+#include <exception>
+#include <format>
+#include <iostream>
+
+namespace {
+    struct Case {
+        const char* name;
+        Harness::CaseFunction run;
+    };
+
+    std::vector<Case>& GetCases() {
+        static std::vector<Case> cases;
+        return cases;
+    }
+}
+
+Harness::Registrar::Registrar(const char* name, CaseFunction run) {
+    GetCases().push_back(Case{ name, run });
+}
+
+void Harness::Fail(const char* expression, const char* file, int line) {
+    throw Failure{ std::format("{}:{}: CHECK({}) failed", file, line, expression) };
+}
+
+int Harness::Run(int argc, char* argv[]) {
+    std::string_view filter = argc > 1 ? argv[1] : "";
+    size_t ran = 0;
+    size_t failed = 0;
+
+    for (const Case& test : GetCases()) {
+        if (std::string_view(test.name).find(filter) == std::string_view::npos) {
+            continue;
+        }
+        ++ran;
+        std::cout << "[ RUN  ] " << test.name << std::endl;
+        std::string error;
+        try {
+            test.run();
+        }
+        catch (const Failure& e) {
+            error = e.message;
+        }
+        catch (const std::exception& e) {
+            error = std::string("exception: ") + e.what();
+        }
+
+        if (error.empty()) {
+            std::cout << "[  OK  ] " << test.name << std::endl;
+        }
+        else {
+            ++failed;
+            std::cout << "[ FAIL ] " << test.name << ": " << error << std::endl;
+        }
+    }
+
+    std::cout << std::format("{} ran, {} failed", ran, failed) << std::endl;
+    return failed == 0 && ran > 0 ? 0 : 1;
+}
+
+void Harness::Report(std::string_view label, const Timing& timing, size_t items) {
+    std::string line = std::format("    {:<44} median {:9.4f} ms  min {:9.4f} ms", label, timing.medianMs, timing.minMs);
+    if (items > 0) {
+        line += std::format("  {:8.2f} ns/item", timing.medianMs * 1e6 / static_cast<double>(items));
+    }
+    std::cout << line << std::endl;
+}
+
+void Harness::Note(std::string_view text) {
+    std::cout << "    " << text << std::endl;
+}
+
+void Harness::Consume(const void* value) {
+    static const void* volatile sink;
+    sink = value;
+}
+
+int main(int argc, char* argv[]) {
+    return Harness::Run(argc, argv);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Minimal runner shared by EngineTests and EngineBench. Each executable
+// registers its cases with TEST_CASE / BENCHMARK and runs the ones whose
+// name contains the first command line argument, or all of them.
+namespace Harness {
+    using CaseFunction = void (*)();
+
+    struct Registrar {
+        Registrar(const char* name, CaseFunction run);
+    };
+
+    // Thrown by CHECK, fails the current case only
+    struct Failure {
+        std::string message;
+    };
+
+    [[noreturn]] void Fail(const char* expression, const char* file, int line);
+
+    int Run(int argc, char* argv[]);
+
+    /* ============================================================== */
+    /* Benchmarks                                                     */
+    /* ============================================================== */
+    struct Timing {
+        double minMs = 0.0;
+        double medianMs = 0.0;
+    };
+
+    // Times 'runs' calls of 'body' separately, running 'setup' untimed before each
+    template <typename Setup, typename Body>
+    Timing Measure(size_t runs, Setup&& setup, Body&& body) {
+        std::vector<double> samples;
+        samples.reserve(runs);
+        for (size_t i = 0; i < runs; ++i) {
+            setup();
+            auto start = std::chrono::steady_clock::now();
+            body();
+            samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        return Timing{ samples.front(), samples[samples.size() / 2] };
+    }
+
+    template <typename Body>
+    Timing Measure(size_t runs, Body&& body) {
+        return Measure(runs, [] {}, body);
+    }
+
+    // One result line; with 'items' > 0 the median is also given per item
+    void Report(std::string_view label, const Timing& timing, size_t items = 0);
+    void Note(std::string_view text);
+
+    // Keeps a result alive so the work producing it isn't optimized away
+    void Consume(const void* value);
+
+    // C++ and SDL heap in use and its high-water mark (HeapTracker.cpp)
+    size_t GetHeapBytes();
+    size_t GetPeakHeapBytes();
+    void ResetPeakHeap();
+
+    // Opens a small window with a GL 3.3 context for cases that upload. False,
+    // with a note, when there's no display; the case should return early.
+    bool RequireGL();
+}
+
+#define HARNESS_CONCAT_INNER(a, b) a##b
+#define HARNESS_CONCAT(a, b) HARNESS_CONCAT_INNER(a, b)
+
+#define HARNESS_CASE(name)                                                                  \
+    static void name();                                                                     \
+    static const Harness::Registrar HARNESS_CONCAT(name, Registrar){ #name, &name };        \
+    static void name()
+
+#define TEST_CASE(name) HARNESS_CASE(name)
+#define BENCHMARK(name) HARNESS_CASE(name)
+
+#define CHECK(expression)                                                                   \
+    do {                                                                                    \
+        if (!(expression)) {                                                                \
+            Harness::Fail(#expression, __FILE__, __LINE__);                                 \
+        }                                                                                   \
+    } while (false)
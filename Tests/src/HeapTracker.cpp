@@ -0,0 +1,128 @@
+#include "Harness.hpp"
+#include <SDL3/SDL_stdinc.h>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// Counts every C++ and SDL heap allocation of the process, so benchmarks can
+// report peak memory without depending on the OS. Each block carries its
+// size in a header ahead of the pointer handed out.
+namespace {
+    constexpr size_t HeaderSize = alignof(std::max_align_t);
+
+    std::atomic<size_t> g_current{ 0 };
+    std::atomic<size_t> g_peak{ 0 };
+
+    void Track(size_t size) {
+        size_t now = g_current.fetch_add(size, std::memory_order_relaxed) + size;
+        size_t peak = g_peak.load(std::memory_order_relaxed);
+        while (now > peak && !g_peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+        }
+    }
+
+    void* Allocate(size_t size) {
+        unsigned char* block = static_cast<unsigned char*>(std::malloc(size + HeaderSize));
+        if (!block) {
+            return nullptr;
+        }
+        std::memcpy(block, &size, sizeof(size));
+        Track(size);
+        return block + HeaderSize;
+    }
+
+    void Release(void* pointer) {
+        if (!pointer) {
+            return;
+        }
+        unsigned char* block = static_cast<unsigned char*>(pointer) - HeaderSize;
+        size_t size;
+        std::memcpy(&size, block, sizeof(size));
+        g_current.fetch_sub(size, std::memory_order_relaxed);
+        std::free(block);
+    }
+
+    void* Reallocate(void* pointer, size_t size) {
+        if (!pointer) {
+            return Allocate(size);
+        }
+        unsigned char* block = static_cast<unsigned char*>(pointer) - HeaderSize;
+        size_t oldSize;
+        std::memcpy(&oldSize, block, sizeof(oldSize));
+        block = static_cast<unsigned char*>(std::realloc(block, size + HeaderSize));
+        if (!block) {
+            return nullptr;
+        }
+        std::memcpy(block, &size, sizeof(size));
+        g_current.fetch_sub(oldSize, std::memory_order_relaxed);
+        Track(size);
+        return block + HeaderSize;
+    }
+
+    void* SDLCALL SdlMalloc(size_t size) {
+        return Allocate(size);
+    }
+    void* SDLCALL SdlCalloc(size_t count, size_t size) {
+        void* pointer = Allocate(count * size);
+        if (pointer) {
+            std::memset(pointer, 0, count * size);
+        }
+        return pointer;
+    }
+    void* SDLCALL SdlRealloc(void* pointer, size_t size) {
+        return Reallocate(pointer, size);
+    }
+    void SDLCALL SdlFree(void* pointer) {
+        Release(pointer);
+    }
+
+    // Before main, SDL hasn't allocated anything that could be freed through the wrong functions
+    [[maybe_unused]] const bool g_sdlTracked = SDL_SetMemoryFunctions(SdlMalloc, SdlCalloc, SdlRealloc, SdlFree);
+}
+
+size_t Harness::GetHeapBytes() {
+    return g_current.load(std::memory_order_relaxed);
+}
+
+size_t Harness::GetPeakHeapBytes() {
+    return g_peak.load(std::memory_order_relaxed);
+}
+
+void Harness::ResetPeakHeap() {
+    g_peak.store(g_current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void* operator new(size_t size) {
+    if (void* pointer = Allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    Release(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    Release(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    Release(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    Release(pointer);
+}
@@ -0,0 +1,102 @@
+#include "Harness.hpp"
+#include <Util/Log.hpp>
+#include <ctime>
+#include <format>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+namespace {
+    constexpr size_t LineCount = 100'000;
+    constexpr size_t Runs = 10;
+
+    const Util::Logger benchLogger("Bench");
+
+    // Swallows std::cout while a run is timed, so the numbers are the logger's
+    // and not the terminal's
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override {
+            return traits_type::not_eof(c);
+        }
+        std::streamsize xsputn(const char*, std::streamsize count) override {
+            return count;
+        }
+    };
+
+    class DiscardOutput {
+    public:
+        DiscardOutput() : m_previous(std::cout.rdbuf(&m_null)) {}
+        ~DiscardOutput() {
+            std::cout.rdbuf(m_previous);
+        }
+
+    private:
+        NullBuffer m_null;
+        std::streambuf* m_previous;
+    };
+
+    // How each line was prefixed before the clock was cached: a stream, the
+    // shared std::localtime buffer and std::put_time for every line
+    std::string OldTimestamp() {
+        using namespace std::chrono;
+        auto now = system_clock::now();
+        time_t time = system_clock::to_time_t(now);
+        auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
+        std::ostringstream stream;
+        stream << std::put_time(std::localtime(&time), "%H:%M:%S") << '.' << std::setfill('0') << std::setw(3) << ms.count();
+        return stream.str();
+    }
+}
+
+// Text lines to a discarded std::cout, rate limiting off so every line is
+// formatted and written
+BENCHMARK(LoggerThroughput) {
+    Util::Logger::Level level = Util::Logger::GetLogLevel();
+    Util::Logger::SetLogLevel(Util::Logger::Level::Debug);
+    Util::Logger::SetRateLimit(0.0, 0.0);
+
+    Harness::Timing timing;
+    {
+        DiscardOutput discard;
+        timing = Harness::Measure(Runs, [&] {
+            for (size_t i = 0; i < LineCount; ++i) {
+                benchLogger.Info("Loaded texture '{}' (ID {}) size {}x{}", "sheet", i, 512, 512);
+            }
+        });
+    }
+    Harness::Report("Logger::Info, 100k lines", timing, LineCount);
+
+    // The same line with the old timestamp and stream output, for scale
+    std::mutex mutex;
+    {
+        DiscardOutput discard;
+        timing = Harness::Measure(Runs, [&] {
+            for (size_t i = 0; i < LineCount; ++i) {
+                std::string message = std::format("Loaded texture '{}' (ID {}) size {}x{}", "sheet", i, 512, 512);
+                std::lock_guard lock(mutex);
+                std::cout << "\033[32m[" << OldTimestamp() << "] [INFO] [Bench] " << message << "\033[0m" << '\n';
+            }
+        });
+    }
+    Harness::Report("reference: stream + put_time per line", timing, LineCount);
+
+    // Lines under the level cost a comparison
+    Util::Logger::SetLogLevel(Util::Logger::Level::Warn);
+    {
+        DiscardOutput discard;
+        timing = Harness::Measure(Runs, [&] {
+            for (size_t i = 0; i < LineCount; ++i) {
+                benchLogger.Info("Loaded texture '{}' (ID {}) size {}x{}", "sheet", i, 512, 512);
+            }
+        });
+    }
+    Harness::Report("Logger::Info below the level, 100k lines", timing, LineCount);
+
+    // Back to the defaults
+    Util::Logger::SetRateLimit(10.0, 20.0);
+    Util::Logger::SetLogLevel(level);
+}
@@ -0,0 +1,102 @@
+#include "Harness.hpp"
+#include <Renderer/Mipmap.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Renderer;
+
+namespace {
+    // Per pixel and channel, what the SIMD path must reproduce bit for bit
+    std::vector<uint8_t> ReferenceDownsample(const std::vector<uint8_t>& source, uint32_t width, uint32_t height) {
+        uint32_t dstWidth = std::max(1u, width >> 1);
+        uint32_t dstHeight = std::max(1u, height >> 1);
+        std::vector<uint8_t> out(static_cast<size_t>(dstWidth) * dstHeight * 4);
+        auto at = [&](uint32_t x, uint32_t y, int channel) {
+            return source[(static_cast<size_t>(std::min(y, height - 1)) * width + std::min(x, width - 1)) * 4 + channel];
+        };
+        for (uint32_t y = 0; y < dstHeight; ++y) {
+            for (uint32_t x = 0; x < dstWidth; ++x) {
+                for (int channel = 0; channel < 4; ++channel) {
+                    int sum = at(x * 2, y * 2, channel) + at(x * 2 + 1, y * 2, channel) +
+                        at(x * 2, y * 2 + 1, channel) + at(x * 2 + 1, y * 2 + 1, channel);
+                    out[(static_cast<size_t>(y) * dstWidth + x) * 4 + channel] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+        return out;
+    }
+
+    std::vector<uint8_t> RandomPixels(uint32_t width, uint32_t height, uint32_t seed) {
+        std::mt19937 random(seed);
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+        for (uint8_t& value : pixels) {
+            value = static_cast<uint8_t>(random());
+        }
+        return pixels;
+    }
+
+    const std::pair<uint32_t, uint32_t> Sizes[] = {
+        { 1, 1 }, { 1, 2 }, { 2, 1 }, { 1, 9 }, { 9, 1 }, { 3, 3 }, { 4, 4 },
+        { 5, 2 }, { 7, 5 }, { 8, 3 }, { 9, 9 }, { 17, 6 }, { 33, 17 }, { 64, 64 },
+    };
+}
+
+// Even, odd and 1-pixel sides all match the scalar filter, including the
+// columns the 2-pixel SIMD loop leaves to the scalar tail
+TEST_CASE(MipmapDownsampleMatchesScalar) {
+    uint32_t seed = 0;
+    for (auto [width, height] : Sizes) {
+        std::vector<uint8_t> source = RandomPixels(width, height, ++seed);
+        std::vector<uint8_t> expected = ReferenceDownsample(source, width, height);
+        // One guard byte past the level catches writes off the end
+        std::vector<uint8_t> out(expected.size() + 1, 0xA5);
+        Mipmap::Downsample(source.data(), width, height, out.data());
+        CHECK(std::equal(expected.begin(), expected.end(), out.begin()));
+        CHECK(out.back() == 0xA5);
+    }
+}
+
+// Build fills each level from the one before, as Downsample would
+TEST_CASE(MipmapBuildChain) {
+    uint32_t seed = 100;
+    for (auto [width, height] : Sizes) {
+        uint32_t levels = Mipmap::LevelCount(width, height);
+        std::vector<uint8_t> chain(Mipmap::ChainBytes(width, height, levels));
+        std::vector<uint8_t> level = RandomPixels(width, height, ++seed);
+        std::copy(level.begin(), level.end(), chain.begin());
+        Mipmap::Build(chain.data(), width, height, levels);
+
+        size_t offset = level.size();
+        for (uint32_t n = 1; n < levels; ++n) {
+            level = ReferenceDownsample(level, std::max(1u, width >> (n - 1)), std::max(1u, height >> (n - 1)));
+            CHECK(level.size() == Mipmap::LevelBytes(width, height, n));
+            CHECK(std::equal(level.begin(), level.end(), chain.begin() + static_cast<ptrdiff_t>(offset)));
+            offset += level.size();
+        }
+        CHECK(offset == chain.size());
+    }
+}
+
+TEST_CASE(MipmapLevelMath) {
+    CHECK(Mipmap::LevelCount(1, 1) == 1);
+    CHECK(Mipmap::LevelCount(2, 1) == 2);
+    CHECK(Mipmap::LevelCount(7, 5) == 3);
+    CHECK(Mipmap::LevelCount(256, 256) == 9);
+    CHECK(Mipmap::LevelCount(1, 300) == 9);
+
+    CHECK(Mipmap::ChainBytes(1, 1, 1) == 4);
+    CHECK(Mipmap::ChainBytes(4, 4, 3) == (16 + 4 + 1) * 4);
+    CHECK(Mipmap::ChainBytes(7, 5, 3) == (35 + 6 + 1) * 4);
+    CHECK(Mipmap::ChainBytes(8, 1, 4) == (8 + 4 + 2 + 1) * 4);
+
+    CHECK(Mipmap::FirstLevelWithin(256, 256, 256) == 0);
+    CHECK(Mipmap::FirstLevelWithin(256, 256, 255) == 1);
+    CHECK(Mipmap::FirstLevelWithin(1024, 64, 100) == 4);
+    CHECK(Mipmap::FirstLevelWithin(7, 5, 2) == 2);
+    // Never past the 1x1 level
+    CHECK(Mipmap::FirstLevelWithin(16, 16, 0) == 4);
+    CHECK(Mipmap::FirstLevelWithin(1, 1, 0) == 0);
+}
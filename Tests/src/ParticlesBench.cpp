@@ -0,0 +1,61 @@
+#include "Harness.hpp"
+#include <Renderer/Particles.hpp>
+#include <Renderer/SpriteBatch.hpp>
+
+using namespace Renderer;
+
+namespace {
+    constexpr size_t ParticleCount = 100'000;
+    constexpr float FrameTime = 1.0f / 240.0f;
+    constexpr size_t Frames = 240;
+}
+
+// Integration only: nothing dies while it's timed
+BENCHMARK(ParticlesUpdate100k) {
+    EmitterSettings settings;
+    settings.lifetime = 60.0f;
+    settings.lifetimeVariance = 0.0f;
+    settings.gravity = Math::Vector2f(0.0f, 500.0f);
+    settings.drag = 0.5f;
+
+    ParticleEmitter emitter(ParticleCount, settings);
+    emitter.Burst(Math::Vector2f(640.0f, 360.0f), ParticleCount);
+    CHECK(emitter.GetCount() == ParticleCount);
+
+    Harness::Timing timing = Harness::Measure(Frames, [&] { emitter.Update(FrameTime); });
+    CHECK(emitter.GetCount() == ParticleCount);
+    Harness::Report("Update, 100k live", timing, ParticleCount);
+}
+
+// Hit effects: short lives, a refill burst every frame, so swap-removes are part of it
+BENCHMARK(ParticlesChurn100k) {
+    EmitterSettings settings;
+    settings.lifetime = 0.25f;
+    ParticleEmitter emitter(ParticleCount, settings);
+    emitter.Burst(Math::Vector2f(640.0f, 360.0f), ParticleCount);
+
+    size_t spawned = 0;
+    Harness::Timing timing = Harness::Measure(Frames, [&] {
+        emitter.Update(FrameTime);
+        spawned += emitter.Burst(Math::Vector2f(640.0f, 360.0f), ParticleCount - emitter.GetCount());
+    });
+    CHECK(spawned > 0);
+    Harness::Report("Update + refill burst, 100k", timing, ParticleCount);
+}
+
+BENCHMARK(ParticlesEmit100k) {
+    EmitterSettings settings;
+    settings.lifetime = 60.0f;
+    ParticleEmitter emitter(ParticleCount, settings);
+    emitter.Burst(Math::Vector2f(640.0f, 360.0f), ParticleCount);
+
+    SpriteBatch batch(ParticleCount);
+    Harness::Timing timing = Harness::Measure(Frames, [&] {
+        batch.Clear();
+        emitter.Emit(batch);
+    });
+    CHECK(batch.GetSpriteCount() == ParticleCount);
+    CHECK(batch.GetRanges().size() == 1);
+    Harness::Consume(batch.GetVertices().data());
+    Harness::Report("Emit into SpriteBatch, 100k", timing, ParticleCount);
+}
@@ -0,0 +1,151 @@
+#include "Harness.hpp"
+#include <Core/Queue.hpp>
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr uint64_t ItemCount = 1'000'000;
+    constexpr uint64_t RoundTrips = 100'000;
+    constexpr size_t Capacity = 1024;
+    constexpr size_t ProducerCount = 4;
+    constexpr size_t Runs = 5;
+
+    // What the lock-free queues replace: a deque behind a mutex, bounded the same way
+    template <typename T>
+    class LockedQueue {
+    public:
+        explicit LockedQueue(size_t capacity) : m_capacity(capacity) {}
+
+        bool TryPush(const T& value) {
+            std::lock_guard lock(m_mutex);
+            if (m_items.size() == m_capacity) {
+                return false;
+            }
+            m_items.push_back(value);
+            return true;
+        }
+
+        bool TryPop(T& value) {
+            std::lock_guard lock(m_mutex);
+            if (m_items.empty()) {
+                return false;
+            }
+            value = m_items.front();
+            m_items.pop_front();
+            return true;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::deque<T> m_items;
+        size_t m_capacity;
+    };
+
+    template <typename Try>
+    void Retry(Try&& attempt) {
+        while (!attempt()) {
+            std::this_thread::yield();
+        }
+    }
+
+    // 'producers' threads push ItemCount values between them, this thread pops them all
+    template <typename Queue>
+    Harness::Timing Throughput(size_t producers) {
+        uint64_t sum = 0;
+        Harness::Timing timing = Harness::Measure(Runs, [&] {
+            Queue queue(Capacity);
+            std::vector<std::thread> threads;
+            for (size_t p = 0; p < producers; ++p) {
+                threads.emplace_back([&queue, p, producers] {
+                    for (uint64_t i = p; i < ItemCount; i += producers) {
+                        Retry([&] { return queue.TryPush(i); });
+                    }
+                });
+            }
+            for (uint64_t received = 0; received < ItemCount; ++received) {
+                uint64_t value = 0;
+                Retry([&] { return queue.TryPop(value); });
+                sum += value;
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        });
+        CHECK(sum == Runs * (ItemCount * (ItemCount - 1) / 2));
+        return timing;
+    }
+
+    // One value bounced between two threads through a queue each way
+    template <typename Queue>
+    Harness::Timing PingPong() {
+        return Harness::Measure(Runs, [] {
+            Queue ping(Capacity);
+            Queue pong(Capacity);
+            std::thread echo([&] {
+                for (uint64_t i = 0; i < RoundTrips; ++i) {
+                    uint64_t value = 0;
+                    Retry([&] { return ping.TryPop(value); });
+                    Retry([&] { return pong.TryPush(value); });
+                }
+            });
+            for (uint64_t i = 0; i < RoundTrips; ++i) {
+                uint64_t value = 0;
+                Retry([&] { return ping.TryPush(i); });
+                Retry([&] { return pong.TryPop(value); });
+            }
+            echo.join();
+        });
+    }
+
+    struct Message : Core::MpscNode {
+        uint64_t value = 0;
+    };
+}
+
+BENCHMARK(QueueThroughput) {
+    Harness::Report("SpscQueue, 1 -> 1, 1M", Throughput<Core::SpscQueue<uint64_t>>(1), ItemCount);
+    Harness::Report("MpmcQueue, 1 -> 1, 1M", Throughput<Core::MpmcQueue<uint64_t>>(1), ItemCount);
+    Harness::Report("reference: mutex + deque, 1 -> 1, 1M", Throughput<LockedQueue<uint64_t>>(1), ItemCount);
+    Harness::Report("MpmcQueue, 4 -> 1, 1M", Throughput<Core::MpmcQueue<uint64_t>>(ProducerCount), ItemCount);
+    Harness::Report("reference: mutex + deque, 4 -> 1, 1M", Throughput<LockedQueue<uint64_t>>(ProducerCount), ItemCount);
+
+    // Intrusive, so the producers push nodes they own rather than values
+    std::unique_ptr<Message[]> messages = std::make_unique<Message[]>(ItemCount);
+    uint64_t sum = 0;
+    Harness::Timing timing = Harness::Measure(Runs, [&] {
+        Core::MpscQueue<Message> queue;
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < ProducerCount; ++p) {
+            threads.emplace_back([&, p] {
+                for (uint64_t i = p; i < ItemCount; i += ProducerCount) {
+                    messages[i].value = i;
+                    queue.Push(&messages[i]);
+                }
+            });
+        }
+        for (uint64_t received = 0; received < ItemCount; ++received) {
+            Message* message = nullptr;
+            Retry([&] { return (message = queue.TryPop()) != nullptr; });
+            sum += message->value;
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    });
+    CHECK(sum == Runs * (ItemCount * (ItemCount - 1) / 2));
+    Harness::Report("MpscQueue, 4 -> 1, 1M", timing, ItemCount);
+}
+
+// Per round trip, so twice the hand-off latency. With fewer cores than
+// threads this mostly measures the scheduler.
+BENCHMARK(QueuePingPong) {
+    Harness::Note(std::format("{} hardware threads", std::thread::hardware_concurrency()));
+    Harness::Report("SpscQueue round trip, 100k", PingPong<Core::SpscQueue<uint64_t>>(), RoundTrips);
+    Harness::Report("MpmcQueue round trip, 100k", PingPong<Core::MpmcQueue<uint64_t>>(), RoundTrips);
+    Harness::Report("reference: mutex + deque round trip, 100k", PingPong<LockedQueue<uint64_t>>(), RoundTrips);
+}
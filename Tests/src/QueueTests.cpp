@@ -0,0 +1,236 @@
+#include "Harness.hpp"
+#include <Core/Queue.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr size_t ProducerCount = 4;
+    constexpr size_t ConsumerCount = 4;
+    constexpr uint64_t ItemsPerProducer = 50'000;
+
+    uint64_t MakeItem(uint64_t producer, uint64_t sequence) {
+        return producer << 32 | sequence;
+    }
+
+    // Spinning threads yield, so the tests also finish on a single core
+    template <typename Try>
+    void Retry(Try&& attempt) {
+        while (!attempt()) {
+            std::this_thread::yield();
+        }
+    }
+
+    struct Message : Core::MpscNode {
+        uint64_t producer = 0;
+        uint64_t sequence = 0;
+    };
+}
+
+/* ============================================================== */
+/* SpscQueue                                                      */
+/* ============================================================== */
+TEST_CASE(SpscFullAndEmpty) {
+    Core::SpscQueue<std::string> queue(5);
+    CHECK(queue.GetCapacity() == 8);
+
+    std::string value;
+    CHECK(!queue.TryPop(value));
+    for (int i = 0; i < 8; ++i) {
+        CHECK(queue.TryPush(std::to_string(i)));
+    }
+    CHECK(queue.GetSizeApprox() == 8);
+
+    // A rejected value isn't moved from
+    std::string extra = "extra";
+    CHECK(!queue.TryPush(std::move(extra)));
+    CHECK(extra == "extra");
+
+    for (int i = 0; i < 8; ++i) {
+        CHECK(queue.TryPop(value));
+        CHECK(value == std::to_string(i));
+    }
+    CHECK(!queue.TryPop(value));
+    CHECK(queue.GetSizeApprox() == 0);
+
+    // Many laps around the ring keep the order
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(queue.TryPush(std::to_string(i)));
+        CHECK(queue.TryPush(std::to_string(i + 1)));
+        CHECK(queue.TryPop(value) && value == std::to_string(i));
+        CHECK(queue.TryPop(value) && value == std::to_string(i + 1));
+    }
+}
+
+TEST_CASE(SpscThreadedFifo) {
+    constexpr uint64_t Count = 200'000;
+    Core::SpscQueue<uint64_t> queue(64);
+
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < Count; ++i) {
+            Retry([&] { return queue.TryPush(i); });
+        }
+    });
+
+    bool ordered = true;
+    for (uint64_t expected = 0; expected < Count; ++expected) {
+        uint64_t value = 0;
+        Retry([&] { return queue.TryPop(value); });
+        ordered = ordered && value == expected;
+    }
+    producer.join();
+
+    CHECK(ordered);
+    uint64_t value = 0;
+    CHECK(!queue.TryPop(value));
+}
+
+/* ============================================================== */
+/* MpscQueue                                                      */
+/* ============================================================== */
+TEST_CASE(MpscEmptyAndReuse) {
+    Core::MpscQueue<Message> queue;
+    CHECK(queue.IsEmpty());
+    CHECK(queue.TryPop() == nullptr);
+
+    Message first;
+    Message second;
+    first.sequence = 1;
+    second.sequence = 2;
+    queue.Push(&first);
+    queue.Push(&second);
+    CHECK(!queue.IsEmpty());
+    CHECK(queue.TryPop() == &first);
+    CHECK(queue.TryPop() == &second);
+    CHECK(queue.TryPop() == nullptr);
+    CHECK(queue.IsEmpty());
+
+    // Popped nodes can go around again
+    queue.Push(&second);
+    queue.Push(&first);
+    CHECK(queue.TryPop() == &second);
+    CHECK(queue.TryPop() == &first);
+    CHECK(queue.IsEmpty());
+}
+
+// Every node arrives once, each producer's in the order it pushed them
+TEST_CASE(MpscPerProducerFifo) {
+    Core::MpscQueue<Message> queue;
+    std::vector<std::unique_ptr<Message[]>> messages;
+    for (size_t p = 0; p < ProducerCount; ++p) {
+        messages.push_back(std::make_unique<Message[]>(ItemsPerProducer));
+    }
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < ProducerCount; ++p) {
+        producers.emplace_back([&, p] {
+            for (uint64_t i = 0; i < ItemsPerProducer; ++i) {
+                Message& message = messages[p][i];
+                message.producer = p;
+                message.sequence = i;
+                queue.Push(&message);
+            }
+        });
+    }
+
+    std::vector<uint64_t> next(ProducerCount, 0);
+    bool ordered = true;
+    for (uint64_t received = 0; received < ProducerCount * ItemsPerProducer; ++received) {
+        Message* message = nullptr;
+        Retry([&] { return (message = queue.TryPop()) != nullptr; });
+        ordered = ordered && message->sequence == next[message->producer];
+        ++next[message->producer];
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    CHECK(ordered);
+    for (uint64_t count : next) {
+        CHECK(count == ItemsPerProducer);
+    }
+    CHECK(queue.TryPop() == nullptr);
+    CHECK(queue.IsEmpty());
+}
+
+/* ============================================================== */
+/* MpmcQueue                                                      */
+/* ============================================================== */
+TEST_CASE(MpmcFullAndEmpty) {
+    Core::MpmcQueue<int> queue(3);
+    CHECK(queue.GetCapacity() == 4);
+
+    int value = 0;
+    CHECK(!queue.TryPop(value));
+    for (int i = 0; i < 4; ++i) {
+        CHECK(queue.TryPush(i));
+    }
+    CHECK(!queue.TryPush(4));
+    CHECK(queue.GetSizeApprox() == 4);
+
+    for (int i = 0; i < 4; ++i) {
+        CHECK(queue.TryPop(value));
+        CHECK(value == i);
+    }
+    CHECK(!queue.TryPop(value));
+    CHECK(queue.GetSizeApprox() == 0);
+    CHECK(queue.TryPush(5));
+    CHECK(queue.TryPop(value) && value == 5);
+}
+
+// Every item is popped exactly once, and no consumer sees a producer's items
+// out of order. A small ring keeps both the full and the empty path busy.
+TEST_CASE(MpmcExactlyOnce) {
+    Core::MpmcQueue<uint64_t> queue(16);
+    std::unique_ptr<std::atomic<uint8_t>[]> seen(new std::atomic<uint8_t>[ProducerCount * ItemsPerProducer]);
+    for (size_t i = 0; i < ProducerCount * ItemsPerProducer; ++i) {
+        seen[i].store(0, std::memory_order_relaxed);
+    }
+    std::atomic<uint64_t> popped{ 0 };
+    std::atomic<size_t> disorder{ 0 };
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < ProducerCount; ++p) {
+        threads.emplace_back([&, p] {
+            for (uint64_t i = 0; i < ItemsPerProducer; ++i) {
+                Retry([&] { return queue.TryPush(MakeItem(p, i)); });
+            }
+        });
+    }
+    for (size_t c = 0; c < ConsumerCount; ++c) {
+        threads.emplace_back([&] {
+            std::vector<int64_t> last(ProducerCount, -1);
+            while (popped.load(std::memory_order_relaxed) < ProducerCount * ItemsPerProducer) {
+                uint64_t item = 0;
+                if (!queue.TryPop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                popped.fetch_add(1, std::memory_order_relaxed);
+                uint64_t producer = item >> 32;
+                int64_t sequence = static_cast<int64_t>(item & 0xFFFFFFFFu);
+                if (sequence <= last[producer]) {
+                    disorder.fetch_add(1, std::memory_order_relaxed);
+                }
+                last[producer] = sequence;
+                seen[producer * ItemsPerProducer + sequence].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(popped.load() == ProducerCount * ItemsPerProducer);
+    CHECK(disorder.load() == 0);
+    size_t wrong = 0;
+    for (size_t i = 0; i < ProducerCount * ItemsPerProducer; ++i) {
+        wrong += seen[i].load(std::memory_order_relaxed) != 1 ? 1 : 0;
+    }
+    CHECK(wrong == 0);
+    uint64_t item = 0;
+    CHECK(!queue.TryPop(item));
+}
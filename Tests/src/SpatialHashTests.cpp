@@ -0,0 +1,222 @@
+#include "Harness.hpp"
+#include <Core/Exceptions.hpp>
+#include <Physics/SpatialHash.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace Physics;
+
+namespace {
+    template <typename Body>
+    bool Throws(Body&& body) {
+        try {
+            body();
+        }
+        catch (const Core::Exception&) {
+            return true;
+        }
+        return false;
+    }
+
+    bool Less(const BodyPair& lhs, const BodyPair& rhs) {
+        return lhs.a != rhs.a ? lhs.a < rhs.a : lhs.b < rhs.b;
+    }
+
+    bool Equal(const BodyPair& lhs, const BodyPair& rhs) {
+        return lhs.a == rhs.a && lhs.b == rhs.b;
+    }
+
+    // The shapes as inserted, to check the grid against brute force
+    struct Body {
+        bool circle = false;
+        AABB box;
+        Circle round;
+    };
+
+    bool Overlap(const Body& a, const Body& b) {
+        if (a.circle && b.circle) {
+            return Intersects(a.round, b.round);
+        }
+        if (a.circle) {
+            return Intersects(b.box, a.round);
+        }
+        if (b.circle) {
+            return Intersects(a.box, b.round);
+        }
+        return Intersects(a.box, b.box);
+    }
+
+    // Whole-number coordinates, so centers recovered from bounds are exact
+    std::vector<Body> RandomBodies(size_t count, uint32_t seed) {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<int> position(0, 400);
+        std::uniform_int_distribution<int> extent(1, 40);
+        std::vector<Body> bodies(count);
+        for (Body& body : bodies) {
+            Math::Vector2f at(static_cast<float>(position(random)), static_cast<float>(position(random)));
+            body.circle = random() % 2 == 0;
+            if (body.circle) {
+                body.round = Circle(at, static_cast<float>(extent(random)));
+            }
+            else {
+                body.box = AABB(at, at + Math::Vector2f(static_cast<float>(extent(random)), static_cast<float>(extent(random))));
+            }
+        }
+        return bodies;
+    }
+
+    BodyID Add(SpatialHash& grid, const Body& body) {
+        return body.circle ? grid.Insert(body.round) : grid.Insert(body.box);
+    }
+}
+
+/* ============================================================== */
+/* Bodies and queries                                             */
+/* ============================================================== */
+TEST_CASE(SpatialHashInsertUpdateRemove) {
+    SpatialHash grid(10.0f);
+    BodyID box = grid.Insert(AABB(Math::Vector2f(0.0f, 0.0f), Math::Vector2f(5.0f, 5.0f)));
+    BodyID wide = grid.Insert(AABB(Math::Vector2f(0.0f, 0.0f), Math::Vector2f(25.0f, 5.0f)));
+    BodyID round = grid.Insert(Circle(Math::Vector2f(50.0f, 50.0f), 4.0f));
+    CHECK(grid.GetBodyCount() == 3 && grid.GetCellCount() == 7);
+    CHECK(grid.IsValid(box) && grid.IsValid(wide) && grid.IsValid(round));
+
+    std::vector<BodyID> hits;
+    grid.QueryPoint(Math::Vector2f(2.0f, 2.0f), hits);
+    std::sort(hits.begin(), hits.end());
+    CHECK((hits == std::vector<BodyID>{ box, wide }));
+
+    // Circles answer for their shape, not their bounds
+    hits.clear();
+    grid.QueryPoint(Math::Vector2f(53.5f, 53.5f), hits);
+    CHECK(hits.empty());
+    grid.QueryPoint(Math::Vector2f(52.0f, 52.0f), hits);
+    CHECK((hits == std::vector<BodyID>{ round }));
+
+    // Spanning several query cells, 'wide' is still reported once
+    hits.clear();
+    grid.QueryBox(AABB(Math::Vector2f(-5.0f, -5.0f), Math::Vector2f(30.0f, 30.0f)), hits);
+    std::sort(hits.begin(), hits.end());
+    CHECK((hits == std::vector<BodyID>{ box, wide }));
+
+    grid.Update(wide, AABB(Math::Vector2f(40.0f, 40.0f), Math::Vector2f(45.0f, 45.0f)));
+    CHECK(grid.GetBounds(wide).min.x == 40.0f);
+    hits.clear();
+    grid.QueryBox(AABB(Math::Vector2f(40.0f, 40.0f), Math::Vector2f(60.0f, 60.0f)), hits);
+    std::sort(hits.begin(), hits.end());
+    CHECK((hits == std::vector<BodyID>{ wide, round }));
+
+    grid.Remove(box);
+    CHECK(!grid.IsValid(box) && grid.GetBodyCount() == 2);
+    CHECK(Throws([&] { grid.Remove(box); }));
+    CHECK(Throws([&] { grid.Update(box, AABB(Math::Vector2f(0.0f, 0.0f), Math::Vector2f(1.0f, 1.0f))); }));
+    hits.clear();
+    grid.QueryPoint(Math::Vector2f(2.0f, 2.0f), hits);
+    CHECK(hits.empty());
+
+    grid.Clear();
+    CHECK(grid.GetBodyCount() == 0 && grid.GetCellCount() == 0);
+}
+
+// The last inserted body is on top, also when it reuses a lower ID
+TEST_CASE(SpatialHashPickOrder) {
+    SpatialHash grid(10.0f);
+    AABB square(Math::Vector2f(0.0f, 0.0f), Math::Vector2f(8.0f, 8.0f));
+    BodyID first = grid.Insert(square);
+    BodyID second = grid.Insert(square);
+    BodyID third = grid.Insert(square);
+    CHECK(grid.Pick(Math::Vector2f(4.0f, 4.0f)) == third);
+    CHECK(grid.Pick(Math::Vector2f(9.0f, 4.0f)) == std::nullopt);
+
+    grid.Remove(first);
+    BodyID recycled = grid.Insert(square);
+    CHECK(recycled == first);
+    CHECK(grid.Pick(Math::Vector2f(4.0f, 4.0f)) == recycled);
+
+    // Moving a body doesn't change its place in the order
+    grid.Update(second, AABB(Math::Vector2f(2.0f, 2.0f), Math::Vector2f(9.0f, 9.0f)));
+    CHECK(grid.Pick(Math::Vector2f(4.0f, 4.0f)) == recycled);
+    CHECK(grid.Pick(Math::Vector2f(8.5f, 8.5f)) == second);
+}
+
+/* ============================================================== */
+/* Pairs                                                          */
+/* ============================================================== */
+// FindPairs reports every overlapping pair once, and the 4-wide FilterPairs
+// keeps exactly the pairs a scalar test over every pair keeps
+TEST_CASE(SpatialHashCollideMatchesBruteForce) {
+    for (uint32_t seed = 1; seed <= 4; ++seed) {
+        // Odd counts leave pairs for the scalar tail
+        std::vector<Body> bodies = RandomBodies(301 + seed, seed);
+        SpatialHash grid(32.0f);
+        std::vector<BodyID> ids;
+        for (const Body& body : bodies) {
+            ids.push_back(Add(grid, body));
+        }
+
+        std::vector<BodyPair> expected;
+        for (size_t i = 0; i < bodies.size(); ++i) {
+            for (size_t j = i + 1; j < bodies.size(); ++j) {
+                if (Overlap(bodies[i], bodies[j])) {
+                    expected.push_back(BodyPair{ std::min(ids[i], ids[j]), std::max(ids[i], ids[j]) });
+                }
+            }
+        }
+
+        std::vector<BodyPair> pairs;
+        grid.FindPairs(pairs);
+        std::vector<BodyPair> unique = pairs;
+        std::sort(unique.begin(), unique.end(), Less);
+        CHECK(std::adjacent_find(unique.begin(), unique.end(), Equal) == unique.end());
+
+        grid.FilterPairs(pairs);
+        std::sort(pairs.begin(), pairs.end(), Less);
+        std::sort(expected.begin(), expected.end(), Less);
+        CHECK(pairs.size() == expected.size());
+        CHECK(std::equal(pairs.begin(), pairs.end(), expected.begin(), expected.end(), Equal));
+
+        std::vector<BodyPair> collided;
+        grid.Collide(collided);
+        std::sort(collided.begin(), collided.end(), Less);
+        CHECK(std::equal(collided.begin(), collided.end(), expected.begin(), expected.end(), Equal));
+    }
+}
+
+/* ============================================================== */
+/* Bounds                                                         */
+/* ============================================================== */
+// NaN, infinite and grid-sized bounds are refused before anything is stored,
+// and far coordinates clamp to the grid edge instead of overflowing
+TEST_CASE(SpatialHashRejectsBadBounds) {
+    constexpr float Nan = std::numeric_limits<float>::quiet_NaN();
+    constexpr float Inf = std::numeric_limits<float>::infinity();
+
+    SpatialHash grid(10.0f);
+    CHECK(Throws([&] { grid.Insert(AABB(Math::Vector2f(Nan, 0.0f), Math::Vector2f(1.0f, 1.0f))); }));
+    CHECK(Throws([&] { grid.Insert(AABB(Math::Vector2f(0.0f, 0.0f), Math::Vector2f(Inf, 1.0f))); }));
+    CHECK(Throws([&] { grid.Insert(Circle(Math::Vector2f(0.0f, 0.0f), Nan)); }));
+    CHECK(Throws([&] { grid.Insert(AABB(Math::Vector2f(-1e30f, -1e30f), Math::Vector2f(1e30f, 1e30f))); }));
+    CHECK(grid.GetBodyCount() == 0 && grid.GetCellCount() == 0);
+
+    BodyID id = grid.Insert(AABB(Math::Vector2f(0.0f, 0.0f), Math::Vector2f(5.0f, 5.0f)));
+    CHECK(Throws([&] { grid.Update(id, AABB(Math::Vector2f(0.0f, -Inf), Math::Vector2f(5.0f, 5.0f))); }));
+    CHECK(grid.GetBounds(id).max.x == 5.0f && grid.GetCellCount() == 1);
+
+    // One cell at each edge of the clamped grid
+    BodyID far = grid.Insert(AABB(Math::Vector2f(1e30f, 1e30f), Math::Vector2f(2e30f, 2e30f)));
+    BodyID near = grid.Insert(AABB(Math::Vector2f(-2e30f, -2e30f), Math::Vector2f(-1e30f, -1e30f)));
+    CHECK(grid.GetCellCount() == 3);
+
+    // A query covering the whole grid walks the three occupied cells
+    std::vector<BodyID> hits;
+    grid.QueryBox(AABB(Math::Vector2f(-Inf, -Inf), Math::Vector2f(Inf, Inf)), hits);
+    CHECK(hits.size() == 3);
+
+    grid.Remove(far);
+    grid.Remove(near);
+    CHECK(grid.GetCellCount() == 1);
+}
@@ -0,0 +1,78 @@
+#include "Harness.hpp"
+#include <Util/StringInterner.hpp>
+#include <format>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr size_t NameCount = 4096;
+    constexpr size_t LookupCount = 1'000'000;
+    constexpr size_t Runs = 10;
+
+    // Texture names the way skins spell them: a shared prefix, then the file
+    std::vector<std::string> MakeNames() {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < NameCount; ++i) {
+            names.push_back(std::format("skins/default/gameplay/note_lane{}_{}.png", i % 7, i));
+        }
+        return names;
+    }
+
+    std::vector<uint32_t> MakeOrder() {
+        std::mt19937 random(1234);
+        std::vector<uint32_t> order(LookupCount);
+        for (uint32_t& index : order) {
+            index = static_cast<uint32_t>(random() % NameCount);
+        }
+        return order;
+    }
+}
+
+// What TextureManager's maps pay per lookup keyed by StringId against keyed
+// by the string itself, and the cost of getting an ID from text
+BENCHMARK(StringIdLookup) {
+    std::vector<std::string> names = MakeNames();
+    std::vector<uint32_t> order = MakeOrder();
+
+    std::vector<Util::StringId> ids;
+    std::unordered_map<Util::StringId, uint32_t> byId;
+    std::unordered_map<std::string, uint32_t> byString;
+    for (uint32_t i = 0; i < NameCount; ++i) {
+        ids.push_back(Util::Intern(names[i]));
+        byId.emplace(ids.back(), i);
+        byString.emplace(names[i], i);
+    }
+
+    uint64_t sum = 0;
+    Harness::Timing timing = Harness::Measure(Runs, [&] {
+        for (uint32_t index : order) {
+            sum += byId.find(ids[index])->second;
+        }
+    });
+    Harness::Report("unordered_map<StringId> find, 1M", timing, LookupCount);
+
+    timing = Harness::Measure(Runs, [&] {
+        for (uint32_t index : order) {
+            sum += byString.find(names[index])->second;
+        }
+    });
+    Harness::Report("unordered_map<std::string> find, 1M", timing, LookupCount);
+
+    // The string API pays this on top of the StringId lookup
+    timing = Harness::Measure(Runs, [&] {
+        for (uint32_t index : order) {
+            sum += Util::Intern(names[index]).GetValue();
+        }
+    });
+    Harness::Report("Intern of a known name, 1M", timing, LookupCount);
+
+    timing = Harness::Measure(Runs, [&] {
+        for (uint32_t index : order) {
+            sum += ids[index].View().size();
+        }
+    });
+    Harness::Report("StringId::View, 1M", timing, LookupCount);
+    Harness::Consume(&sum);
+}
@@ -0,0 +1,96 @@
+#include "Harness.hpp"
+#include <Util/Hash.hpp>
+#include <Util/StringInterner.hpp>
+#include <atomic>
+#include <cstring>
+#include <format>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using Util::StringId;
+
+TEST_CASE(InternerRoundTrip) {
+    StringId shrek = Util::Intern("tests/shrek.png");
+    CHECK(!shrek.IsEmpty());
+    CHECK(Util::Intern("tests/shrek.png") == shrek);
+    CHECK(Util::Intern(std::string("tests/") + "shrek.png") == shrek);
+    CHECK(Util::Intern("tests/shrek.jpg") != shrek);
+
+    CHECK(shrek.View() == "tests/shrek.png");
+    CHECK(std::strcmp(shrek.CStr(), "tests/shrek.png") == 0);
+    CHECK(shrek.GetHash() == Util::Fnv1a("tests/shrek.png"));
+    CHECK(std::format("[{}]", shrek) == "[tests/shrek.png]");
+
+    CHECK(Util::Intern("").IsEmpty());
+    CHECK(StringId().View().empty());
+    CHECK(Util::StringInterner::Get().Find("tests/never interned") == std::nullopt);
+    CHECK(Util::StringInterner::Get().Find("tests/shrek.png") == shrek);
+}
+
+// Past the arena block size, and enough names to grow the table and add chunks
+TEST_CASE(InternerGrowth) {
+    std::string big(100'000, 'x');
+    big += "tests/big";
+    StringId bigId = Util::Intern(big);
+    CHECK(bigId.View() == big);
+
+    constexpr size_t Count = 20'000;
+    std::vector<StringId> ids;
+    std::vector<const char*> texts;
+    for (size_t i = 0; i < Count; ++i) {
+        ids.push_back(Util::Intern(std::format("tests/growth/{}.png", i)));
+        texts.push_back(ids.back().CStr());
+    }
+
+    std::unordered_set<StringId> unique(ids.begin(), ids.end());
+    CHECK(unique.size() == Count);
+    for (size_t i = 0; i < Count; ++i) {
+        // Text never moves once interned
+        CHECK(ids[i].CStr() == texts[i]);
+        CHECK(ids[i].View() == std::format("tests/growth/{}.png", i));
+    }
+    CHECK(bigId.View() == big);
+}
+
+// Threads interning the same names in different orders get the same IDs,
+// while readers go from IDs to text without the lock. Run it under TSan.
+TEST_CASE(InternerConcurrent) {
+    constexpr size_t ThreadCount = 8;
+    constexpr size_t NameCount = 5'000;
+
+    std::vector<std::vector<StringId>> seen(ThreadCount, std::vector<StringId>(NameCount));
+    std::atomic<bool> start{ false };
+    std::atomic<size_t> mismatches{ 0 };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back([&, t] {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t n = 0; n < NameCount; ++n) {
+                // Odd threads walk the names backwards
+                size_t i = t % 2 == 0 ? n : NameCount - 1 - n;
+                std::string name = std::format("tests/concurrent/{}", i);
+                StringId id = Util::Intern(name);
+                if (id.View() != name || Util::StringInterner::Get().Find(name) != id) {
+                    mismatches.fetch_add(1, std::memory_order_relaxed);
+                }
+                seen[t][i] = id;
+            }
+        });
+    }
+    start.store(true, std::memory_order_release);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(mismatches.load() == 0);
+    for (size_t t = 1; t < ThreadCount; ++t) {
+        CHECK(seen[t] == seen[0]);
+    }
+    std::unordered_set<StringId> unique(seen[0].begin(), seen[0].end());
+    CHECK(unique.size() == NameCount);
+}
@@ -0,0 +1,118 @@
+#include "Harness.hpp"
+#include <Renderer/StateCache.hpp>
+#include <Renderer/TextureManager.hpp>
+#include <SDL3/SDL.h>
+#if _WIN32
+#include <SDL3/SDL_image.h>
+#else
+#include <SDL3_image/SDL_image.h>
+#endif
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <vector>
+
+using namespace Renderer;
+
+namespace {
+    constexpr int Width = 3840;
+    constexpr int Height = 2160;
+    constexpr size_t Runs = 10;
+
+    // A 4K song background as a 32-bit BMP: cheap to decode, so the time left
+    // is conversion and upload, and BGRA so a conversion is needed
+    std::string WriteBackground() {
+        std::string path = (std::filesystem::temp_directory_path() / "EngineBench_4k.bmp").string();
+        SDL_Surface* surface = SDL_CreateSurface(Width, Height, SDL_PIXELFORMAT_ARGB8888);
+        CHECK(surface != nullptr);
+        for (int y = 0; y < Height; ++y) {
+            Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch);
+            for (int x = 0; x < Width; ++x) {
+                row[x] = 0xFF000000u | static_cast<Uint32>((x * 255 / Width) << 16 | (y * 255 / Height) << 8 | ((x ^ y) & 0xFF));
+            }
+        }
+        bool saved = SDL_SaveBMP(surface, path.c_str());
+        SDL_DestroySurface(surface);
+        CHECK(saved);
+        return path;
+    }
+
+    std::string Megabytes(size_t bytes) {
+        return std::format("{:.1f} MiB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+    }
+
+    // What AddTextureFromFile did before rows were uploaded top-first: convert
+    // into a second surface, flip into a third buffer, upload from CPU memory
+    GLuint LoadFlipped(const std::string& path) {
+        SDL_Surface* surface = IMG_Load(path.c_str());
+        SDL_Surface* converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ABGR8888);
+        SDL_DestroySurface(surface);
+
+        int width = converted->w;
+        int height = converted->h;
+        Uint32* pixels = static_cast<Uint32*>(converted->pixels);
+        std::vector<Uint32> flipped(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y) {
+            std::memcpy(&flipped[static_cast<size_t>(y) * width], &pixels[static_cast<size_t>(height - 1 - y) * (converted->pitch / 4)],
+                width * sizeof(Uint32));
+        }
+
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        StateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        StateCache::Get().BindTexture(texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, flipped.data());
+        SDL_DestroySurface(converted);
+        return texture;
+    }
+}
+
+// Time to a finished upload (glFinish) and the heap high-water mark above
+// what was in use before the load, for the current and the old path
+BENCHMARK(TextureLoad4K) {
+    if (!Harness::RequireGL()) {
+        return;
+    }
+    std::string path = WriteBackground();
+
+    {
+        TextureManager textures;
+        size_t peak = 0;
+        Harness::Timing timing = Harness::Measure(Runs, [&] {
+            if (textures.FindSizeByName("background")) {
+                textures.RemoveTextureByName("background");
+            }
+            glFinish();
+            Harness::ResetPeakHeap();
+        }, [&] {
+            size_t before = Harness::GetHeapBytes();
+            textures.AddTextureFromFile("background", path);
+            glFinish();
+            peak = std::max(peak, Harness::GetPeakHeapBytes() - before);
+        });
+        Harness::Report("AddTextureFromFile, 3840x2160 BGRA", timing);
+        Harness::Note("peak heap above baseline: " + Megabytes(peak));
+    }
+
+    size_t peak = 0;
+    GLuint texture = 0;
+    Harness::Timing timing = Harness::Measure(Runs, [&] {
+        if (texture != 0) {
+            glDeleteTextures(1, &texture);
+            StateCache::Get().OnTextureDeleted(texture);
+        }
+        glFinish();
+        Harness::ResetPeakHeap();
+    }, [&] {
+        size_t before = Harness::GetHeapBytes();
+        texture = LoadFlipped(path);
+        glFinish();
+        peak = std::max(peak, Harness::GetPeakHeapBytes() - before);
+    });
+    glDeleteTextures(1, &texture);
+    StateCache::Get().OnTextureDeleted(texture);
+    Harness::Report("reference: convert + flip + glTexImage2D", timing);
+    Harness::Note("peak heap above baseline: " + Megabytes(peak));
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,89 @@
+#include "Harness.hpp"
+#include <Renderer/GL.hpp>
+#include <Renderer/TextureManager.hpp>
+#include <SDL3/SDL.h>
+#include <filesystem>
+#include <string>
+
+using namespace Renderer;
+
+namespace {
+    // A small 32-bit BMP in the temp directory; 'tint' changes every pixel
+    std::string WriteImage(const std::string& file, int width, int height, Uint32 tint) {
+        std::string path = (std::filesystem::temp_directory_path() / file).string();
+        SDL_Surface* surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ARGB8888);
+        CHECK(surface != nullptr);
+        for (int y = 0; y < height; ++y) {
+            Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch);
+            for (int x = 0; x < width; ++x) {
+                row[x] = 0xFF000000u | static_cast<Uint32>(x * 16 << 8 | y * 16) ^ tint;
+            }
+        }
+        bool saved = SDL_SaveBMP(surface, path.c_str());
+        SDL_DestroySurface(surface);
+        CHECK(saved);
+        return path;
+    }
+
+    void FinishLoads(TextureManager& textures) {
+        for (int frame = 0; textures.GetPendingLoadCount() > 0; ++frame) {
+            CHECK(frame < 5000);
+            textures.PumpUploads();
+            SDL_Delay(1);
+        }
+        textures.PumpUploads();
+    }
+}
+
+// Files with the same pixels share one texture, which lives until its last
+// name is removed. An image of another size gets its own.
+TEST_CASE(TextureContentAliasing) {
+    if (!Harness::RequireGL()) {
+        return;
+    }
+    std::string first = WriteImage("EngineTests_alias_a.bmp", 8, 4, 0);
+    std::string second = WriteImage("EngineTests_alias_b.bmp", 8, 4, 0);
+    std::string transposed = WriteImage("EngineTests_alias_c.bmp", 4, 8, 0);
+
+    TextureManager textures;
+    GLuint id = textures.AddTextureFromFile("a", first)->id;
+    CHECK(textures.AddTextureFromFile("b", second)->id == id);
+    CHECK(textures.AddTextureFromFile("c", transposed)->id != id);
+    textures.PumpUploads();
+    CHECK(textures.GetStats().aliasCount == 1);
+
+    textures.RemoveTextureByName("a");
+    CHECK(textures.FindTextureByName("b") == id);
+    CHECK(glIsTexture(id));
+
+    textures.RemoveTextureByName("b");
+    CHECK(!textures.FindSizeByName("b").has_value());
+    CHECK(!glIsTexture(id));
+}
+
+// Editing one alias's file moves only that name to a texture of its own
+TEST_CASE(TextureContentSplitOnReload) {
+    if (!Harness::RequireGL()) {
+        return;
+    }
+    std::string first = WriteImage("EngineTests_split_a.bmp", 8, 4, 0);
+    std::string second = WriteImage("EngineTests_split_b.bmp", 8, 4, 0);
+
+    TextureManager textures;
+    GLuint shared = textures.AddTextureFromFile("a", first)->id;
+    CHECK(textures.AddTextureFromFile("b", second)->id == shared);
+
+    WriteImage("EngineTests_split_b.bmp", 8, 4, 0x00FF00FFu);
+    CHECK(textures.ReloadFile(second) == 1);
+    FinishLoads(textures);
+
+    GLuint moved = textures.FindTextureByName("b");
+    CHECK(moved != 0 && moved != shared);
+    CHECK(textures.FindTextureByName("a") == shared);
+    CHECK(textures.GetStats().aliasCount == 0);
+
+    // The old texture now belongs to 'a' alone
+    textures.RemoveTextureByName("a");
+    CHECK(!glIsTexture(shared));
+    CHECK(glIsTexture(moved));
+}
@@ -0,0 +1,205 @@
+#include <Core/AssetPack.hpp>
+#include <Core/Exceptions.hpp>
+#include <Renderer/Mipmap.hpp>
+#include <Util/Hash.hpp>
+#include <Util/Log.hpp>
+#include <SDL3/SDL.h>
+#if _WIN32
+#include <SDL3/SDL_image.h>
+#else
+#include <SDL3_image/SDL_image.h>
+#endif
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace Core;
+
+namespace {
+    Util::Logger logger("AssetCooker");
+
+    struct CookedAsset {
+        std::string name;
+        PackFormat::Entry entry{};
+        std::vector<uint8_t> data;
+    };
+
+    bool IsImage(const fs::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg" ||
+            extension == ".bmp" || extension == ".tga" || extension == ".webp";
+    }
+
+    /* ============================================================== */
+    /* Textures                                                       */
+    /* ============================================================== */
+    CookedAsset CookTexture(const fs::path& path, bool mips) {
+        SDL_Surface* decoded = IMG_Load(path.string().c_str());
+        if (!decoded) {
+            throw Exception("Failed to load image '" + path.string() + "': " + SDL_GetError());
+        }
+        SDL_Surface* surface = SDL_ConvertSurface(decoded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(decoded);
+        if (!surface) {
+            throw Exception("Failed to convert '" + path.string() + "': " + SDL_GetError());
+        }
+
+        CookedAsset asset;
+        uint32_t width = static_cast<uint32_t>(surface->w);
+        uint32_t height = static_cast<uint32_t>(surface->h);
+        uint32_t levels = mips ? Renderer::Mipmap::LevelCount(width, height) : 1;
+        asset.data.resize(Renderer::Mipmap::ChainBytes(width, height, levels));
+
+        size_t rowBytes = static_cast<size_t>(width) * 4;
+        for (uint32_t y = 0; y < height; ++y) {
+            std::memcpy(asset.data.data() + y * rowBytes, static_cast<const uint8_t*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch, rowBytes);
+        }
+        SDL_DestroySurface(surface);
+
+        Renderer::Mipmap::Build(asset.data.data(), width, height, levels);
+
+        asset.entry.type = PackFormat::AssetType::Texture;
+        asset.entry.width = width;
+        asset.entry.height = height;
+        asset.entry.mipCount = levels;
+        return asset;
+    }
+
+    CookedAsset CookBlob(const fs::path& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw Exception("Failed to open '" + path.string() + "'");
+        }
+
+        CookedAsset asset;
+        asset.data.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(asset.data.data()), static_cast<std::streamsize>(asset.data.size()));
+        asset.entry.type = PackFormat::AssetType::Blob;
+        return asset;
+    }
+
+    /* ============================================================== */
+    /* Pack                                                           */
+    /* ============================================================== */
+    void Pad(std::ofstream& out, uint64_t& position, size_t alignment) {
+        static const char zeros[PackFormat::DataAlignment] = {};
+        size_t padding = (alignment - position % alignment) % alignment;
+        out.write(zeros, static_cast<std::streamsize>(padding));
+        position += padding;
+    }
+
+    void WritePack(const fs::path& output, std::vector<CookedAsset>& assets) {
+        std::sort(assets.begin(), assets.end(),
+            [](const CookedAsset& a, const CookedAsset& b) { return a.entry.hash < b.entry.hash; });
+
+        fs::path directory = output.parent_path();
+        if (!directory.empty()) {
+            fs::create_directories(directory);
+        }
+        // Written to the side and renamed, a running game may have the old one mapped
+        fs::path temporary = output;
+        temporary += ".tmp";
+
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw Exception("Failed to create '" + temporary.string() + "'");
+        }
+
+        PackFormat::Header header{};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint64_t position = sizeof(header);
+
+        for (CookedAsset& asset : assets) {
+            Pad(out, position, PackFormat::DataAlignment);
+            asset.entry.offset = position;
+            asset.entry.size = asset.data.size();
+            out.write(reinterpret_cast<const char*>(asset.data.data()), static_cast<std::streamsize>(asset.data.size()));
+            position += asset.data.size();
+        }
+
+        Pad(out, position, alignof(PackFormat::Entry));
+        header.magic = PackFormat::Magic;
+        header.version = PackFormat::Version;
+        header.entryCount = static_cast<uint32_t>(assets.size());
+        header.indexOffset = position;
+        for (const CookedAsset& asset : assets) {
+            out.write(reinterpret_cast<const char*>(&asset.entry), sizeof(asset.entry));
+        }
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        if (!out) {
+            throw Exception("Failed to write '" + temporary.string() + "'");
+        }
+        fs::rename(temporary, output);
+    }
+
+    int Cook(const fs::path& input, const fs::path& output, bool mips) {
+        std::vector<fs::path> files;
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input)) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        std::vector<CookedAsset> assets;
+        std::unordered_map<uint64_t, std::string> names;
+        size_t sourceBytes = 0;
+        for (const fs::path& file : files) {
+            std::string name = fs::relative(file, input).generic_string();
+            CookedAsset asset = IsImage(file) ? CookTexture(file, mips) : CookBlob(file);
+            asset.name = name;
+            asset.entry.hash = Util::Fnv1a(name);
+
+            auto [it, inserted] = names.emplace(asset.entry.hash, name);
+            if (!inserted) {
+                throw Exception("Hash collision between '" + it->second + "' and '" + name + "'");
+            }
+
+            sourceBytes += static_cast<size_t>(fs::file_size(file));
+            if (asset.entry.type == PackFormat::AssetType::Texture) {
+                logger.Info("{}: {}x{}, {} mip levels", name, asset.entry.width, asset.entry.height, asset.entry.mipCount);
+            }
+            else {
+                logger.Info("{}: {} bytes", name, asset.data.size());
+            }
+            assets.push_back(std::move(asset));
+        }
+
+        WritePack(output, assets);
+        logger.Info("Wrote {} assets to '{}' ({} KiB from {} KiB of sources)", assets.size(), output.string(),
+            fs::file_size(output) / 1024, sourceBytes / 1024);
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        logger.Error("Usage: AssetCooker <input directory> <output pack> [--no-mips]");
+        return 1;
+    }
+
+    bool mips = !(argc > 3 && std::strcmp(argv[3], "--no-mips") == 0);
+    try {
+        return Cook(argv[1], argv[2], mips);
+    }
+    catch (const Exception& e) {
+        logger.Error("{}", e.what());
+    }
+    catch (const fs::filesystem_error& e) {
+        logger.Error("{}", e.what());
+    }
+    return 1;
+}
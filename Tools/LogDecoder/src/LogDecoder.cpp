@@ -0,0 +1,264 @@
+#include <Core/Exceptions.hpp>
+#include <Core/MappedFile.hpp>
+#include <Util/BinaryLog.hpp>
+#include <Util/Log.hpp>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+using namespace Util::BinaryLogFormat;
+
+namespace {
+    Util::Logger logger("LogDecoder");
+
+    struct Site {
+        Util::Logger::Level level;
+        std::vector<ArgType> types;
+        std::string_view scope;
+        std::string_view file;
+        uint32_t line;
+        std::string_view format;
+    };
+
+    using Value = std::variant<int64_t, uint64_t, double, bool, char, std::string_view, const void*>;
+
+    // Bounds-checked reads from the mapping
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+        template <typename T>
+        bool Read(T& value) {
+            if (m_size - m_offset < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&value, m_data + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+            return true;
+        }
+
+        bool ReadBytes(size_t size, std::string_view& bytes) {
+            if (m_size - m_offset < size) {
+                return false;
+            }
+            bytes = std::string_view(reinterpret_cast<const char*>(m_data + m_offset), size);
+            m_offset += size;
+            return true;
+        }
+
+    private:
+        const uint8_t* m_data;
+        size_t m_size;
+        size_t m_offset = 0;
+    };
+
+    /* ============================================================== */
+    /* Text                                                           */
+    /* ============================================================== */
+    std::string FormatValue(const std::string& spec, const Value& value) {
+        return std::visit([&spec](auto argument) {
+            try {
+                return std::vformat(spec, std::make_format_args(argument));
+            }
+            catch (const std::format_error&) {
+                // A spec meant for the original type, e.g. a number formatted to text up front
+                return std::format("{}", argument);
+            }
+        }, value);
+    }
+
+    // Replays std::format's replacement fields with one argument at a time
+    std::string FormatMessage(std::string_view format, const std::vector<Value>& args) {
+        std::string message;
+        size_t nextArg = 0;
+        for (size_t i = 0; i < format.size(); ++i) {
+            char c = format[i];
+            if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+                message += c;
+                ++i;
+                continue;
+            }
+            if (c != '{') {
+                message += c;
+                continue;
+            }
+
+            size_t close = format.find('}', i);
+            if (close == std::string_view::npos) {
+                message.append(format.substr(i));
+                break;
+            }
+            std::string_view field = format.substr(i + 1, close - i - 1);
+            size_t colon = field.find(':');
+            std::string_view index = field.substr(0, colon);
+            size_t arg = nextArg++;
+            if (!index.empty()) {
+                std::from_chars(index.data(), index.data() + index.size(), arg);
+            }
+
+            std::string spec = "{" + std::string(colon != std::string_view::npos ? field.substr(colon) : "") + "}";
+            message += arg < args.size() ? FormatValue(spec, args[arg]) : "{?}";
+            i = close;
+        }
+        return message;
+    }
+
+    // HH:MM:SS.mmm local time, like the console output
+    std::string FormatTime(int64_t wallClockNs) {
+        time_t second = static_cast<time_t>(wallClockNs / 1'000'000'000);
+        int millis = static_cast<int>(wallClockNs / 1'000'000 % 1000);
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &second);
+#else
+        localtime_r(&second, &local);
+#endif
+        char clock[16];
+        std::strftime(clock, sizeof(clock), "%H:%M:%S", &local);
+        return std::format("{}.{:03}", clock, millis);
+    }
+
+    /* ============================================================== */
+    /* Records                                                        */
+    /* ============================================================== */
+    bool ReadSite(Reader& reader, Site& site) {
+        SiteInfo info{};
+        std::string_view types;
+        if (!reader.Read(info) || !reader.ReadBytes(info.argCount, types) || !reader.ReadBytes(info.scopeLength, site.scope) ||
+            !reader.ReadBytes(info.fileLength, site.file) || !reader.ReadBytes(info.formatLength, site.format)) {
+            return false;
+        }
+        site.level = static_cast<Util::Logger::Level>(info.level);
+        site.line = info.line;
+        for (char type : types) {
+            site.types.push_back(static_cast<ArgType>(type));
+        }
+        return true;
+    }
+
+    bool ReadArgs(Reader& reader, const Site& site, std::vector<Value>& args) {
+        args.clear();
+        for (ArgType type : site.types) {
+            bool ok = false;
+            switch (type) {
+            case ArgType::Int: { int64_t v; ok = reader.Read(v); args.emplace_back(v); break; }
+            case ArgType::UInt: { uint64_t v; ok = reader.Read(v); args.emplace_back(v); break; }
+            case ArgType::Double: { double v; ok = reader.Read(v); args.emplace_back(v); break; }
+            case ArgType::Bool: { bool v; ok = reader.Read(v); args.emplace_back(v); break; }
+            case ArgType::Char: { char v; ok = reader.Read(v); args.emplace_back(v); break; }
+            case ArgType::Pointer: {
+                uint64_t v;
+                ok = reader.Read(v);
+                args.emplace_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(v)));
+                break;
+            }
+            case ArgType::String: {
+                uint32_t length;
+                std::string_view v;
+                ok = reader.Read(length) && reader.ReadBytes(length, v);
+                args.emplace_back(v);
+                break;
+            }
+            }
+            if (!ok) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int Decode(const std::string& inputPath, std::ostream& out) {
+        Core::MappedFile file(inputPath);
+        const uint8_t* data = file.GetData();
+        size_t size = file.GetSize();
+
+        Header header{};
+        if (size >= sizeof(Header)) {
+            std::memcpy(&header, data, sizeof(header));
+        }
+        if (header.magic != Magic) {
+            throw Core::Exception("'" + inputPath + "' is not a binary log");
+        }
+        if (header.version != Version) {
+            throw Core::Exception("'" + inputPath + "' is version " + std::to_string(header.version) +
+                ", expected " + std::to_string(Version));
+        }
+
+        // Sites first: a message can be written before its site's record
+        std::unordered_map<uint64_t, Site> sites;
+        std::vector<std::pair<size_t, RecordHeader>> messages;
+        for (size_t offset = sizeof(Header); offset + sizeof(RecordHeader) <= size;) {
+            RecordHeader record{};
+            std::memcpy(&record, data + offset, sizeof(record));
+            if (record.size < sizeof(RecordHeader) || record.size > size - offset) {
+                break;
+            }
+
+            if (record.kind == RecordKind::Site) {
+                Reader reader(data + offset + sizeof(RecordHeader), record.size - sizeof(RecordHeader));
+                Site site;
+                if (ReadSite(reader, site)) {
+                    sites.emplace(record.site, std::move(site));
+                }
+            }
+            else if (record.kind == RecordKind::Message) {
+                messages.emplace_back(offset, record);
+            }
+            offset += record.size;
+        }
+
+        size_t unknown = 0;
+        std::vector<Value> args;
+        for (const auto& [offset, record] : messages) {
+            int64_t wallClockNs = header.wallClockNs + static_cast<int64_t>(record.timestampNs - header.steadyNs);
+            auto site = sites.find(record.site);
+            Reader reader(data + offset + sizeof(RecordHeader), record.size - sizeof(RecordHeader));
+            if (site == sites.end() || !ReadArgs(reader, site->second, args)) {
+                out << "[" << FormatTime(wallClockNs) << "] [?] site " << std::format("{:016x}", record.site) << '\n';
+                ++unknown;
+                continue;
+            }
+
+            out << "[" << FormatTime(wallClockNs) << "] "
+                << "[" << Util::Logger::GetLevelName(site->second.level) << "] "
+                << "[" << site->second.scope << "] "
+                << FormatMessage(site->second.format, args) << '\n';
+        }
+
+        if (unknown > 0) {
+            logger.Warn("{} of {} messages had no readable site record", unknown, messages.size());
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        logger.Error("Usage: LogDecoder <binary log> [output text file]");
+        return 1;
+    }
+
+    try {
+        if (argc < 3) {
+            return Decode(argv[1], std::cout);
+        }
+
+        std::ofstream out(argv[2]);
+        if (!out) {
+            throw Core::Exception(std::string("Failed to create '") + argv[2] + "'");
+        }
+        return Decode(argv[1], out);
+    }
+    catch (const Core::Exception& e) {
+        logger.Error("{}", e.what());
+    }
+    return 1;
+}